@@ -0,0 +1,34 @@
+dnl
+dnl Check how to link programs using std::thread/std::async
+dnl
+dnl Only mkvmerge runs code on a second thread (closing finished
+dnl output files), so the flag is only used for linking it.
+
+AC_CACHE_CHECK([for the flag required for linking with threads], [ax_cv_pthread_flag],[
+  AC_LANG_PUSH(C++)
+  CXXFLAGS_SAVED="$CXXFLAGS"
+  LIBS_SAVED="$LIBS"
+  CXXFLAGS="$CXXFLAGS $STD_CXX"
+  ax_cv_pthread_flag="none"
+
+  for flag in -pthread -lpthread ; do
+    LIBS="$LIBS_SAVED $flag"
+    AC_TRY_LINK([#include <future>],
+      [auto result = std::async(std::launch::async, []() { return 42; }); return result.get() != 42;],
+      [ax_cv_pthread_flag="$flag"])
+    if test x"$ax_cv_pthread_flag" != xnone ; then
+      break
+    fi
+  done
+
+  AC_LANG_POP
+  CXXFLAGS="$CXXFLAGS_SAVED"
+  LIBS="$LIBS_SAVED"
+])
+
+PTHREAD_LIBS=""
+if test x"$ax_cv_pthread_flag" != xnone ; then
+  PTHREAD_LIBS="$ax_cv_pthread_flag"
+fi
+
+AC_SUBST(PTHREAD_LIBS)
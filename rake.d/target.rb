@@ -150,6 +150,7 @@ class Target
       when :boost_system     then c(:BOOST_SYSTEM_LIB)
       when :qt               then qt_libraries
       when :wxwidgets        then c(:WXWIDGETS_LIBS)
+      when :pthread          then c(:PTHREAD_LIBS)
       when :static           then c(:LINK_STATICALLY)
       when :mpegparser       then [ '-Lsrc/mpegparser', '-lmpegparser'  ]
       when :mtxinput         then [ '-Lsrc/input',      '-lmtxinput'    ]
@@ -386,9 +386,6 @@ frame_c::to_string(bool verbose)
 parser_c::parser_c()
   : m_fixed_buffer{}
   , m_fixed_buffer_size{}
-  , m_parsed_stream_position{}
-  , m_total_stream_position{}
-  , m_garbage_size{}
   , m_num_frames_found{}
   , m_abort_after_num_frames{}
   , m_require_frame_at_first_byte{}
@@ -403,19 +400,6 @@ parser_c::add_timecode(timecode_c const &timecode) {
   m_provided_timecodes.push_back(timecode);
 }
 
-void
-parser_c::add_bytes(memory_cptr const &mem) {
-  add_bytes(mem->get_buffer(), mem->get_size());
-}
-
-void
-parser_c::add_bytes(unsigned char const *buffer,
-                    size_t size) {
-  m_buffer.add(buffer, size);
-  m_total_stream_position += size;
-  parse();
-}
-
 void
 parser_c::parse_fixed_buffer(unsigned char const *fixed_buffer,
                              size_t fixed_buffer_size) {
@@ -426,7 +410,7 @@ parser_c::parse_fixed_buffer(unsigned char const *fixed_buffer,
 
   m_fixed_buffer      = fixed_buffer;
   m_fixed_buffer_size = fixed_buffer_size;
-  parse();
+  parse_buffer(false);
 }
 
 void
@@ -434,11 +418,6 @@ parser_c::parse_fixed_buffer(memory_cptr const &fixed_buffer) {
   parse_fixed_buffer(fixed_buffer->get_buffer(), fixed_buffer->get_size());
 }
 
-void
-parser_c::flush() {
-  // no-op
-}
-
 void
 parser_c::abort_after_num_frames(size_t num_frames) {
   m_abort_after_num_frames = num_frames;
@@ -454,16 +433,9 @@ parser_c::copy_data(bool copy) {
   m_copy_data = copy;
 }
 
-size_t
-parser_c::frames_available()
-  const {
-  return m_frames.size();
-}
-
 frame_c
 parser_c::get_frame() {
-  auto frame = m_frames.front();
-  m_frames.pop_front();
+  auto frame = pop_frame();
 
   if (!frame.m_header.is_valid)
     frame.m_header = m_header;
@@ -471,18 +443,6 @@ parser_c::get_frame() {
   return frame;
 }
 
-uint64_t
-parser_c::get_total_stream_position()
-  const {
-  return m_total_stream_position;
-}
-
-uint64_t
-parser_c::get_parsed_stream_position()
-  const {
-  return m_parsed_stream_position;
-}
-
 bool
 parser_c::headers_parsed()
   const {
@@ -517,6 +477,9 @@ parser_c::decode_adts_header(unsigned char const *buffer,
     if (frame.m_header.bytes >  buffer_size)
       return { need_more_data, 0 };
 
+    if (frame.m_header.bytes < (protection_absent ? 7u : 9u))
+      return { failure, 1 };
+
     bc.skip_bits(11);                              // adts_buffer_fullness
     bc.skip_bits(2);                               // no_raw_blocks_in_frame
     if (!protection_absent)
@@ -529,10 +492,9 @@ parser_c::decode_adts_header(unsigned char const *buffer,
     frame.m_header.data_byte_size   = frame.m_header.bytes - frame.m_header.header_byte_size;
     frame.m_header.is_valid         = true;
 
-    if (m_copy_data) {
-      frame.m_data = memory_c::alloc(frame.m_header.data_byte_size);
-      bc.get_bytes(frame.m_data->get_buffer(), frame.m_header.data_byte_size);
-    }
+    // The ADTS header always ends on a byte boundary.
+    if (m_copy_data)
+      frame.m_data = get_frame_data(&buffer[frame.m_header.header_byte_size], frame.m_header.data_byte_size);
 
     push_frame(frame);
 
@@ -663,8 +625,33 @@ parser_c::push_frame(frame_c &frame) {
   ++m_num_frames_found;
 }
 
+/** \brief Find the next position a supported header may start at
+
+   \return The offset of the next candidate for an ADTS or a LOAS/LATM
+     sync word (depending on the multiplex type found so far) or \c
+     buffer_size if there is none.
+*/
+size_t
+parser_c::find_next_sync_word(unsigned char const *buffer,
+                              size_t buffer_size)
+  const {
+  auto adts = loas_latm_multiplex == m_multiplex_type ? buffer_size : mtx::frame_sync::find_sync_word(buffer, buffer_size, AAC_ADTS_SYNC_WORD >> 16, (AAC_ADTS_SYNC_WORD >> 8) & 0xff, (AAC_ADTS_SYNC_WORD_MASK >> 8) & 0xff);
+  auto loas = adts_multiplex      == m_multiplex_type ? buffer_size : mtx::frame_sync::find_sync_word(buffer, buffer_size, AAC_LOAS_SYNC_WORD >> 16, (AAC_LOAS_SYNC_WORD >> 8) & 0xff, (AAC_LOAS_SYNC_WORD_MASK >> 8) & 0xff);
+
+  return std::min(adts, loas);
+}
+
+memory_cptr
+parser_c::get_frame_data(unsigned char const *data,
+                         size_t size) {
+  if (m_fixed_buffer)
+    return memory_c::clone(data, size);
+
+  return m_buffer.get_frame_data(data - m_buffer.get_buffer(), size);
+}
+
 void
-parser_c::parse() {
+parser_c::parse_buffer(bool) {
   if (m_abort_after_num_frames && (m_num_frames_found >= m_abort_after_num_frames))
     return;
 
@@ -692,6 +679,17 @@ parser_c::parse() {
       m_garbage_size += num_bytes;
       if (!m_num_frames_found && m_require_frame_at_first_byte)
         break;
+
+      // Skip over garbage without trying to decode a header at each
+      // position. The last two bytes are kept as they might be the
+      // start of a header continued in the next chunk.
+      remaining_bytes = buffer_size - position;
+      if (remaining_bytes > 2) {
+        auto skip                 = std::min(find_next_sync_word(&buffer[position], remaining_bytes), remaining_bytes - 2);
+        position                 += skip;
+        m_parsed_stream_position += skip;
+        m_garbage_size           += skip;
+      }
     }
 
     if (m_abort_after_num_frames && (m_num_frames_found >= m_abort_after_num_frames))
@@ -19,7 +19,7 @@
 #include <ostream>
 
 #include "common/bit_cursor.h"
-#include "common/byte_buffer.h"
+#include "common/frame_sync_parser.h"
 #include "common/timecode.h"
 
 #define AAC_ID_MPEG4 0
@@ -132,7 +132,7 @@ public:
   std::string to_string(bool verbose = false) const;
 };
 
-class parser_c {
+class parser_c: public frame_sync_parser_c<frame_c> {
 public:
   enum multiplex_type_e {
       unknown_multiplex = 0
@@ -149,13 +149,10 @@ protected:
   };
 
 protected:
-  std::deque<frame_c> m_frames;
   std::deque<timecode_c> m_provided_timecodes;
-  byte_buffer_c m_buffer;
   unsigned char const *m_fixed_buffer;
   size_t m_fixed_buffer_size;
-  uint64_t m_parsed_stream_position, m_total_stream_position;
-  size_t m_garbage_size, m_num_frames_found, m_abort_after_num_frames;
+  size_t m_num_frames_found, m_abort_after_num_frames;
   bool m_require_frame_at_first_byte, m_copy_data;
   multiplex_type_e m_multiplex_type;
   header_c m_header;
@@ -166,20 +163,12 @@ public:
   parser_c();
   void add_timecode(timecode_c const &timecode);
 
-  void add_bytes(memory_cptr const &mem);
-  void add_bytes(unsigned char const *buffer, size_t size);
-
   void parse_fixed_buffer(unsigned char const *fixed_buffer, size_t fixed_buffer_size);
   void parse_fixed_buffer(memory_cptr const &fixed_buffer);
 
-  void flush();
-
-  size_t frames_available() const;
   bool headers_parsed() const;
 
   frame_c get_frame();
-  uint64_t get_parsed_stream_position() const;
-  uint64_t get_total_stream_position() const;
 
   void abort_after_num_frames(size_t num_frames);
   void require_frame_at_first_byte(bool require);
@@ -189,10 +178,12 @@ public:                         // static functions
   static int find_consecutive_frames(unsigned char const *buffer, size_t buffer_size, size_t num_required_frames);
 
 protected:
-  void parse();
+  virtual void parse_buffer(bool end_of_stream);
   std::pair<parse_result_e, size_t> decode_header(unsigned char const *buffer, size_t buffer_size);
   std::pair<parse_result_e, size_t> decode_adts_header(unsigned char const *buffer, size_t buffer_size);
   std::pair<parse_result_e, size_t> decode_loas_latm_header(unsigned char const *buffer, size_t buffer_size);
+  size_t find_next_sync_word(unsigned char const *buffer, size_t buffer_size) const;
+  memory_cptr get_frame_data(unsigned char const *data, size_t size);
   void push_frame(frame_c &frame);
 };
 using parser_cptr = std::shared_ptr<parser_c>;
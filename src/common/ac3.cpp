@@ -246,58 +246,19 @@ ac3::frame_c::to_string(bool verbose)
 
 // ------------------------------------------------------------
 
-ac3::parser_c::parser_c()
-  : m_parsed_stream_position(0)
-  , m_total_stream_position(0)
-  , m_garbage_size(0)
-{
-}
-
-void
-ac3::parser_c::add_bytes(memory_cptr const &mem) {
-  add_bytes(mem->get_buffer(), mem->get_size());
-}
-
-void
-ac3::parser_c::add_bytes(unsigned char *const buffer,
-                         size_t size) {
-  m_buffer.add(buffer, size);
-  m_total_stream_position += size;
-  parse(false);
-}
-
-void
-ac3::parser_c::flush() {
-  parse(true);
-}
-
 size_t
 ac3::parser_c::frame_available()
   const {
-  return m_frames.size();
+  return frames_available();
 }
 
 ac3::frame_c
 ac3::parser_c::get_frame() {
-  frame_c frame = m_frames.front();
-  m_frames.pop_front();
-  return frame;
-}
-
-uint64_t
-ac3::parser_c::get_total_stream_position()
-  const {
-  return m_total_stream_position;
-}
-
-uint64_t
-ac3::parser_c::get_parsed_stream_position()
-  const {
-  return m_parsed_stream_position;
+  return pop_frame();
 }
 
 void
-ac3::parser_c::parse(bool end_of_stream) {
+ac3::parser_c::parse_buffer(bool end_of_stream) {
   unsigned char *const buffer = m_buffer.get_buffer();
   size_t buffer_size          = m_buffer.get_size();
   size_t position             = 0;
@@ -306,8 +267,12 @@ ac3::parser_c::parse(bool end_of_stream) {
     ac3::frame_c frame;
 
     if (!frame.decode_header(&buffer[position], buffer_size - position)) {
-      ++position;
-      ++m_garbage_size;
+      // Skip straight to the next possible sync word instead of
+      // decoding a header at each position.
+      auto next_position  = position + 1 + mtx::frame_sync::find_sync_word(&buffer[position + 1], buffer_size - position - 1, AC3_SYNC_WORD >> 8, AC3_SYNC_WORD & 0xff);
+      next_position       = std::max(std::min(next_position, buffer_size - 8), position + 1);
+      m_garbage_size     += next_position - position;
+      position            = next_position;
       continue;
     }
 
@@ -321,7 +286,7 @@ ac3::parser_c::parse(bool end_of_stream) {
         m_frames.push_back(m_current_frame);
 
       m_current_frame        = frame;
-      m_current_frame.m_data = memory_c::clone(&buffer[position], frame.m_bytes);
+      m_current_frame.m_data = m_buffer.get_frame_data(position, frame.m_bytes);
 
     } else
       m_current_frame.add_dependent_frame(frame, &buffer[position], frame.m_bytes);
@@ -17,7 +17,7 @@
 #include "common/common_pch.h"
 
 #include "common/bit_cursor.h"
-#include "common/byte_buffer.h"
+#include "common/frame_sync_parser.h"
 
 #define AC3_SYNC_WORD           0x0b77
 
@@ -65,27 +65,18 @@ namespace ac3 {
     int find_in(unsigned char const *buffer, size_t buffer_size);
   };
 
-  class parser_c {
+  class parser_c: public frame_sync_parser_c<frame_c> {
   protected:
-    std::deque<frame_c> m_frames;
-    byte_buffer_c m_buffer;
-    uint64_t m_parsed_stream_position, m_total_stream_position;
     frame_c m_current_frame;
-    size_t m_garbage_size;
 
   public:
-    parser_c();
-    void add_bytes(memory_cptr const &mem);
-    void add_bytes(unsigned char *const buffer, size_t size);
-    void flush();
     size_t frame_available() const;
     frame_c get_frame();
-    uint64_t get_parsed_stream_position() const;
-    uint64_t get_total_stream_position() const;
 
     int find_consecutive_frames(unsigned char const *buffer, size_t buffer_size, size_t num_required_headers);
 
-    void parse(bool end_of_stream);
+  protected:
+    virtual void parse_buffer(bool end_of_stream);
   };
 };
 
@@ -17,9 +17,14 @@
 
 #include "common/common_pch.h"
 
+#include "common/math.h"
 #include "common/mm_io_x.h"
 
-class bit_reader_c {
+/* The original implementation extracting at most eight bits per loop
+   iteration. It is kept as the reference the faster bit_reader_c is
+   checked and benchmarked against. */
+
+class bytewise_bit_reader_c {
 private:
   const unsigned char *m_end_of_data;
   const unsigned char *m_byte_position;
@@ -28,7 +33,7 @@ private:
   bool m_out_of_data;
 
 public:
-  bit_reader_c(unsigned char const *data, std::size_t len) {
+  bytewise_bit_reader_c(unsigned char const *data, std::size_t len) {
     init(data, len);
   }
 
@@ -199,6 +204,209 @@ protected:
     }
   }
 };
+
+/* Reads the data through 64-bit big-endian words. get_bits() needs a
+   single bounds check and no loop for up to 57 bits. Near the end of
+   the data missing bytes are read as 0; the bounds check makes sure
+   they are never returned. The behavior (including the exceptions
+   thrown) is the same as the one of bytewise_bit_reader_c. */
+
+class bit_reader_c {
+private:
+  static std::size_t const s_max_bits_per_word = 57;
+
+  unsigned char const *m_data;
+  std::size_t m_size, m_num_bits, m_bit_position;
+  bool m_out_of_data;
+
+public:
+  bit_reader_c(unsigned char const *data, std::size_t len) {
+    init(data, len);
+  }
+
+  void init(const unsigned char *data, std::size_t len) {
+    m_data         = data;
+    m_size         = len;
+    m_num_bits     = len * 8;
+    m_bit_position = 0;
+    m_out_of_data  = !len;
+  }
+
+  bool eof() {
+    return m_out_of_data;
+  }
+
+  uint64_t get_bits(std::size_t n) {
+    if (!n)
+      return 0;
+
+    if (n > s_max_bits_per_word) {
+      auto high = get_bits(n - 32);
+      return (high << 32) | get_bits(32);
+    }
+
+    if ((m_bit_position + n) > m_num_bits) {
+      m_out_of_data = true;
+      throw mtx::mm_io::end_of_file_x();
+    }
+
+    auto value      = (load_word() << (m_bit_position & 7)) >> (64 - n);
+    m_bit_position += n;
+
+    return value;
+  }
+
+  inline int get_bit() {
+    if (m_bit_position >= m_num_bits) {
+      m_out_of_data = true;
+      throw mtx::mm_io::end_of_file_x();
+    }
+
+    auto bit = (m_data[m_bit_position / 8] >> (7 - (m_bit_position & 7))) & 1;
+    ++m_bit_position;
+
+    return bit;
+  }
+
+  inline int get_unary(bool stop,
+                       int len) {
+    int i;
+
+    for (i = 0; (i < len) && get_bit() != stop; ++i)
+      ;
+
+    return i;
+  }
+
+  inline int get_012() {
+    if (!get_bit())
+      return 0;
+    return get_bits(1) + 1;
+  }
+
+  inline int get_unsigned_golomb() {
+    // Codes with up to 28 leading zero bits fit into one word.
+    auto word       = load_word() << (m_bit_position & 7);
+    auto num_zeros  = mtx::math::count_leading_zero_bits(word);
+    auto code_bits  = 2 * num_zeros + 1;
+
+    if ((num_zeros <= 28) && ((m_bit_position + code_bits) <= m_num_bits)) {
+      m_bit_position += code_bits;
+      return (word >> (64 - code_bits)) - 1;
+    }
+
+    int n = 0, bit;
+
+    while ((bit = get_bit()) == 0)
+      ++n;
+
+    bit = get_bits(n);
+
+    return (1 << n) - 1 + bit;
+  }
+
+  inline int get_signed_golomb() {
+    int v = get_unsigned_golomb();
+    return v & 1 ? (v + 1) / 2 : -(v / 2);
+  }
+
+  uint64_t peek_bits(std::size_t n) {
+    if (!n)
+      return 0;
+
+    if ((m_bit_position + n) > m_num_bits)
+      throw mtx::mm_io::end_of_file_x();
+
+    if (n > s_max_bits_per_word) {
+      auto position  = m_bit_position;
+      auto value     = get_bits(n);
+      m_bit_position = position;
+
+      return value;
+    }
+
+    return (load_word() << (m_bit_position & 7)) >> (64 - n);
+  }
+
+  void get_bytes(unsigned char *buf, std::size_t n) {
+    if (!(m_bit_position & 7)) {
+      get_bytes_byte_aligned(buf, n);
+      return;
+    }
+
+    for (auto idx = 0u; idx < n; ++idx)
+      buf[idx] = get_bits(8);
+  }
+
+  void byte_align() {
+    if (m_bit_position & 7)
+      skip_bits(8 - (m_bit_position & 7));
+  }
+
+  void set_bit_position(std::size_t pos) {
+    if (pos >= m_num_bits) {
+      m_bit_position = m_num_bits;
+      m_out_of_data  = true;
+
+      throw mtx::mm_io::end_of_file_x();
+    }
+
+    m_bit_position = pos;
+  }
+
+  int get_bit_position() const {
+    return m_bit_position;
+  }
+
+  int get_remaining_bits() const {
+    return m_num_bits - m_bit_position;
+  }
+
+  void skip_bits(std::size_t num) {
+    set_bit_position(m_bit_position + num);
+  }
+
+  void skip_bit() {
+    set_bit_position(m_bit_position + 1);
+  }
+
+protected:
+  uint64_t load_word() const {
+    auto byte_position = m_bit_position / 8;
+
+    if ((byte_position + 8) <= m_size) {
+      uint64_t word;
+      std::memcpy(&word, &m_data[byte_position], 8);
+
+#if defined(ARCH_BIGENDIAN)
+      return word;
+#elif defined(COMP_MSC)
+      return _byteswap_uint64(word);
+#else
+      return __builtin_bswap64(word);
+#endif
+    }
+
+    uint64_t word = 0;
+    for (auto idx = byte_position; idx < (byte_position + 8); ++idx)
+      word = (word << 8) | (idx < m_size ? m_data[idx] : 0);
+
+    return word;
+  }
+
+  void get_bytes_byte_aligned(unsigned char *buf, std::size_t n) {
+    auto byte_position = m_bit_position / 8;
+    auto bytes_to_copy = std::min<std::size_t>(n, m_size - byte_position);
+    std::memcpy(buf, &m_data[byte_position], bytes_to_copy);
+
+    m_bit_position += bytes_to_copy * 8;
+
+    if (bytes_to_copy < n) {
+      m_out_of_data = true;
+      throw mtx::mm_io::end_of_file_x();
+    }
+  }
+};
 using bit_reader_cptr = std::shared_ptr<bit_reader_c>;
 
 class bit_writer_c {
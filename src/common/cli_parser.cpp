@@ -177,6 +177,8 @@ cli_parser_c::add_common_options() {
   OPT("command-line-charset=<charset>", YT("Charset for strings on the command line"));
   OPT("output-charset=<cset>",          YT("Output messages in this charset"));
   OPT("r|redirect-output=<file>",       YT("Redirects all messages into this file."));
+  OPT("drop-input-from-cache",          YT("Drop data that has been read from the operating system's file cache."));
+  OPT("drop-output-from-cache",         YT("Drop written data from the operating system's file cache."));
   OPT("@file",                          YT("Reads additional command line options from the specified file (see man page)."));
   OPT("h|help",                         YT("Show this help."));
   OPT("V|version",                      YT("Show version information."));
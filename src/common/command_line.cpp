@@ -205,6 +205,14 @@ handle_common_cli_args(std::vector<std::string> &args,
       g_gui_mode = true;
       args.erase(args.begin() + i, args.begin() + i + 1);
 
+    } else if (args[i] == "--drop-output-from-cache") {
+      mm_file_io_c::ms_drop_output_from_cache = true;
+      args.erase(args.begin() + i, args.begin() + i + 1);
+
+    } else if (args[i] == "--drop-input-from-cache") {
+      mm_file_io_c::ms_drop_input_from_cache = true;
+      args.erase(args.begin() + i, args.begin() + i + 1);
+
     } else
       ++i;
   }
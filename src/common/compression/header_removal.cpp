@@ -62,6 +62,14 @@ header_removal_compressor_c::do_compress(memory_cptr const &buffer) {
                                              "Wanted bytes:%1%; found:%2%.")) % b_bytes % b_buffer);
   }
 
+  // Packets are usually referenced by nothing but the packet itself. In
+  // that case the removed header is simply skipped instead of copying
+  // the remainder into a new buffer.
+  if (buffer.unique() && buffer->is_unique()) {
+    buffer->set_offset(buffer->get_offset() + size);
+    return buffer;
+  }
+
   return memory_c::clone(buffer->get_buffer() + size, buffer->get_size() - size);
 }
 
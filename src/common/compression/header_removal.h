@@ -30,6 +30,10 @@ public:
     m_bytes->grab();
   }
 
+  memory_cptr get_bytes() const {
+    return m_bytes;
+  }
+
   virtual memory_cptr do_decompress(memory_cptr const &buffer);
   virtual memory_cptr do_compress(memory_cptr const &buffer);
 
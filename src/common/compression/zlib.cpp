@@ -15,45 +15,110 @@
 
 #include "common/compression/zlib.h"
 
-zlib_compressor_c::zlib_compressor_c()
+zlib_compressor_c::zlib_compressor_c(int compression_level)
   : compressor_c(COMPRESSION_ZLIB)
+  , m_compression_level{compression_level}
+  , m_inflate_initialized{}
+  , m_deflate_initialized{}
+  , m_decompressed_size_hint{}
 {
+  memset(&m_inflate_stream, 0, sizeof(m_inflate_stream));
+  memset(&m_deflate_stream, 0, sizeof(m_deflate_stream));
 }
 
 zlib_compressor_c::~zlib_compressor_c() {
+  if (m_inflate_initialized)
+    inflateEnd(&m_inflate_stream);
+  if (m_deflate_initialized)
+    deflateEnd(&m_deflate_stream);
 }
 
-memory_cptr
-zlib_compressor_c::do_decompress(memory_cptr const &buffer) {
-  z_stream d_stream;
+void
+zlib_compressor_c::set_compression_level(int compression_level) {
+  if (m_deflate_initialized && (m_compression_level != compression_level)) {
+    deflateEnd(&m_deflate_stream);
+    m_deflate_initialized = false;
+  }
+
+  m_compression_level = compression_level;
+}
 
-  d_stream.zalloc = (alloc_func)0;
-  d_stream.zfree  = (free_func)0;
-  d_stream.opaque = (voidpf)0;
-  int result      = inflateInit2(&d_stream, 15 + 32); // 15: window size; 32: look for zlib/gzip headers automatically
+// The streams are initialized once and reset for each following block.
+
+void
+zlib_compressor_c::init_inflate_stream() {
+  if (m_inflate_initialized) {
+    int result = inflateReset(&m_inflate_stream);
+    if (Z_OK != result)
+      mxerror(boost::format(Y("inflateReset() failed. Result: %1%\n")) % result);
+    return;
+  }
+
+  m_inflate_stream.zalloc = (alloc_func)0;
+  m_inflate_stream.zfree  = (free_func)0;
+  m_inflate_stream.opaque = (voidpf)0;
+  int result              = inflateInit2(&m_inflate_stream, 15 + 32); // 15: window size; 32: look for zlib/gzip headers automatically
 
   if (Z_OK != result)
     mxerror(boost::format(Y("inflateInit() failed. Result: %1%\n")) % result);
 
+  m_inflate_initialized = true;
+}
+
+void
+zlib_compressor_c::init_deflate_stream() {
+  if (m_deflate_initialized) {
+    int result = deflateReset(&m_deflate_stream);
+    if (Z_OK != result)
+      mxerror(boost::format(Y("deflateReset() failed. Result: %1%\n")) % result);
+    return;
+  }
+
+  m_deflate_stream.zalloc = (alloc_func)0;
+  m_deflate_stream.zfree  = (free_func)0;
+  m_deflate_stream.opaque = (voidpf)0;
+  int result              = deflateInit(&m_deflate_stream, m_compression_level);
+
+  if (Z_OK != result)
+    mxerror(boost::format(Y("deflateInit() failed. Result: %1%\n")) % result);
+
+  m_deflate_initialized = true;
+}
+
+memory_cptr
+zlib_compressor_c::do_decompress(memory_cptr const &buffer) {
+  init_inflate_stream();
+
+  auto &d_stream     = m_inflate_stream;
   d_stream.next_in   = reinterpret_cast<Bytef *>(buffer->get_buffer());
   d_stream.avail_in  = buffer->get_size();
-  int n              = 0;
-  memory_cptr dst    = memory_c::alloc(0);
 
-  do {
-    n++;
-    dst->resize(n * 4000);
-    d_stream.next_out  = reinterpret_cast<Bytef *>(dst->get_buffer() + (n - 1) * 4000);
-    d_stream.avail_out = 4000;
+  // Blocks of one track usually decompress to similar sizes. Start with
+  // the size of the previous block and double the buffer if needed.
+  auto dst_size      = std::max<size_t>({ m_decompressed_size_hint, buffer->get_size() * 4, 4096 });
+  memory_cptr dst    = memory_c::alloc(dst_size);
+  int result         = Z_OK;
+
+  while (true) {
+    d_stream.next_out  = reinterpret_cast<Bytef *>(dst->get_buffer() + d_stream.total_out);
+    d_stream.avail_out = dst_size - d_stream.total_out;
     result             = inflate(&d_stream, Z_NO_FLUSH);
 
+    if ((Z_BUF_ERROR == result) && !d_stream.avail_in)
+      break;
+
     if ((Z_OK != result) && (Z_STREAM_END != result))
       throw mtx::compression_x(boost::format(Y("Zlib decompression failed. Result: %1%\n")) % result);
 
-  } while ((0 == d_stream.avail_out) && (0 != d_stream.avail_in) && (Z_STREAM_END != result));
+    if ((Z_STREAM_END == result) || (0 != d_stream.avail_out))
+      break;
+
+    dst_size *= 2;
+    dst->resize(dst_size);
+  }
 
   dst->resize(d_stream.total_out);
-  inflateEnd(&d_stream);
+  m_decompressed_size_hint = d_stream.total_out;
 
   mxverb(3, boost::format("zlib_compressor_c: Decompression from %1% to %2%, %3%%%\n") % buffer->get_size() % dst->get_size() % (dst->get_size() * 100 / buffer->get_size()));
 
@@ -62,35 +127,34 @@ zlib_compressor_c::do_decompress(memory_cptr const &buffer) {
 
 memory_cptr
 zlib_compressor_c::do_compress(memory_cptr const &buffer) {
-  z_stream c_stream;
-
-  c_stream.zalloc = (alloc_func)0;
-  c_stream.zfree  = (free_func)0;
-  c_stream.opaque = (voidpf)0;
-  int result      = deflateInit(&c_stream, 9);
-
-  if (Z_OK != result)
-    mxerror(boost::format(Y("deflateInit() failed. Result: %1%\n")) % result);
+  init_deflate_stream();
 
+  auto &c_stream     = m_deflate_stream;
   c_stream.next_in   = (Bytef *)buffer->get_buffer();
   c_stream.avail_in  = buffer->get_size();
-  int n              = 0;
-  memory_cptr dst    = memory_c::alloc(0);
+
+  // deflateBound() is an upper limit for the compressed size so that a
+  // single call to deflate() usually suffices.
+  size_t dst_size    = deflateBound(&c_stream, buffer->get_size());
+  memory_cptr dst    = memory_c::alloc(dst_size);
+  int result         = Z_OK;
 
   do {
-    n++;
-    dst->resize(n * 4000);
-    c_stream.next_out  = reinterpret_cast<Bytef *>(dst->get_buffer() + (n - 1) * 4000);
-    c_stream.avail_out = 4000;
+    if (c_stream.total_out == dst_size) {
+      dst_size *= 2;
+      dst->resize(dst_size);
+    }
+
+    c_stream.next_out  = reinterpret_cast<Bytef *>(dst->get_buffer() + c_stream.total_out);
+    c_stream.avail_out = dst_size - c_stream.total_out;
     result             = deflate(&c_stream, Z_FINISH);
 
     if ((Z_OK != result) && (Z_STREAM_END != result))
       mxerror(boost::format(Y("Zlib decompression failed. Result: %1%\n")) % result);
 
-  } while ((c_stream.avail_out == 0) && (result != Z_STREAM_END));
+  } while (result != Z_STREAM_END);
 
   dst->resize(c_stream.total_out);
-  deflateEnd(&c_stream);
 
   mxverb(3, boost::format("zlib_compressor_c: Compression from %1% to %2%, %3%%%\n") % buffer->get_size() % dst->get_size() % (dst->get_size() * 100 / buffer->get_size()));
 
@@ -21,13 +21,24 @@
 #include "common/compression.h"
 
 class zlib_compressor_c: public compressor_c {
+protected:
+  int m_compression_level;
+  z_stream m_inflate_stream, m_deflate_stream;
+  bool m_inflate_initialized, m_deflate_initialized;
+  size_t m_decompressed_size_hint;
+
 public:
-  zlib_compressor_c();
+  zlib_compressor_c(int compression_level = Z_BEST_COMPRESSION);
   virtual ~zlib_compressor_c();
 
+  void set_compression_level(int compression_level);
+
 protected:
   virtual memory_cptr do_decompress(memory_cptr const &buffer);
   virtual memory_cptr do_compress(memory_cptr const &buffer);
+
+  void init_inflate_stream();
+  void init_deflate_stream();
 };
 
 #endif // MTX_COMMON_COMPRESSION_ZLIB_H
@@ -133,6 +133,31 @@ content_decoder_c::reverse(memory_cptr &memory,
       memory = ce.compressor->decompress(memory);
 }
 
+// Returns the bytes removed by header removal compression if that is
+// the only encoding applied to the given scope. Callers can then write
+// those bytes and the stored data separately instead of reassembling
+// each frame with reverse().
+memory_cptr
+content_decoder_c::get_removed_header(content_encoding_scope_e scope) {
+  if (!is_ok())
+    return memory_cptr{};
+
+  auto removed_header = memory_cptr{};
+
+  for (auto &ce : encodings) {
+    if (0 == (ce.scope & scope))
+      continue;
+
+    auto header_removal = std::dynamic_pointer_cast<header_removal_compressor_c>(ce.compressor);
+    if (!header_removal || removed_header)
+      return memory_cptr{};
+
+    removed_header = header_removal->get_bytes();
+  }
+
+  return removed_header;
+}
+
 std::string
 content_decoder_c::descriptive_algorithm_list() {
   std::string list;
@@ -52,6 +52,7 @@ public:
 
   bool initialize(KaxTrackEntry &ktentry);
   void reverse(memory_cptr &data, content_encoding_scope_e scope);
+  memory_cptr get_removed_header(content_encoding_scope_e scope);
   bool is_ok() {
     return ok;
   }
@@ -17,6 +17,7 @@
 #include "common/bit_cursor.h"
 #include "common/dts.h"
 #include "common/endian.h"
+#include "common/frame_sync_parser.h"
 #include "common/math.h"
 
 // ---------------------------------------------------------------------------
@@ -88,20 +89,24 @@ find_sync_word(unsigned char const *buf,
     // not enough data for one header
     return -1;
 
-  unsigned int offset = 0;
-  auto sync_word      = static_cast<sync_word_e>(get_uint32_be(buf));
-  auto sync_word_ok   = false;
+  size_t offset = 0;
 
   while ((offset + 4) < size) {
-    sync_word_ok = (sync_word_e::core == sync_word) || (sync_word_e::exss == sync_word);
-    if (sync_word_ok)
+    auto core_offset = mtx::frame_sync::find_sync_word(&buf[offset], size - offset, static_cast<uint32_t>(sync_word_e::core) >> 24, (static_cast<uint32_t>(sync_word_e::core) >> 16) & 0xff);
+    auto exss_offset = mtx::frame_sync::find_sync_word(&buf[offset], size - offset, static_cast<uint32_t>(sync_word_e::exss) >> 24, (static_cast<uint32_t>(sync_word_e::exss) >> 16) & 0xff);
+    offset          += std::min(core_offset, exss_offset);
+
+    if ((offset + 4) >= size)
       break;
 
-    sync_word = static_cast<sync_word_e>((static_cast<uint32_t>(sync_word) << 8) | buf[offset + 4]);
+    auto sync_word = static_cast<sync_word_e>(get_uint32_be(&buf[offset]));
+    if ((sync_word_e::core == sync_word) || (sync_word_e::exss == sync_word))
+      return offset;
+
     ++offset;
   }
 
-  return sync_word_ok ? offset : -1;
+  return -1;
 }
 
 static int
@@ -0,0 +1,112 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit http://www.gnu.org/copyleft/gpl.html
+
+   common base of the audio frame parsers
+
+   Written by Moritz Bunkus <moritz@bunkus.org>.
+*/
+
+#include "common/common_pch.h"
+
+#include "common/frame_sync_parser.h"
+
+namespace mtx { namespace frame_sync {
+
+/** \brief Find the next candidate for a two-byte sync word
+
+   The first byte is located with \c memchr which is a lot faster than
+   looking at each position in turn. Only the positions followed by at
+   least one more byte are considered.
+
+   \return The offset of the first position at which \c first_byte is
+     followed by a byte that equals \c second_byte after applying \c
+     second_byte_mask, or \c buffer_size if there is no such position.
+*/
+size_t
+find_sync_word(unsigned char const *buffer,
+               size_t buffer_size,
+               unsigned char first_byte,
+               unsigned char second_byte,
+               unsigned char second_byte_mask) {
+  auto position = 0u;
+
+  while ((position + 1) < buffer_size) {
+    auto found = static_cast<unsigned char const *>(memchr(&buffer[position], first_byte, buffer_size - position - 1));
+    if (!found)
+      break;
+
+    position = found - buffer;
+    if ((buffer[position + 1] & second_byte_mask) == second_byte)
+      return position;
+
+    ++position;
+  }
+
+  return buffer_size;
+}
+
+}}
+
+void
+frame_sync_buffer_c::add(memory_cptr const &mem) {
+  if (!mem->get_size())
+    return;
+
+  if (!m_direct && !m_buffer.get_size() && mem->is_free()) {
+    m_direct = mem;
+    return;
+  }
+
+  add(mem->get_buffer(), mem->get_size());
+}
+
+void
+frame_sync_buffer_c::add(unsigned char const *buffer,
+                         size_t size) {
+  if (!size)
+    return;
+
+  // Bytes left over from referenced data must be kept in front of the
+  // new ones.
+  if (m_direct) {
+    auto direct = m_direct;
+    m_direct.reset();
+    m_buffer.add(direct->get_buffer(), direct->get_size());
+  }
+
+  m_buffer.add(buffer, size);
+}
+
+void
+frame_sync_buffer_c::remove(size_t num) {
+  if (!m_direct) {
+    m_buffer.remove(num);
+    return;
+  }
+
+  // Only the unparsed rest at the end of referenced data is copied.
+  if (num < m_direct->get_size())
+    m_buffer.add(m_direct->get_buffer() + num, m_direct->get_size() - num);
+
+  m_direct.reset();
+}
+
+void
+frame_sync_buffer_c::clear() {
+  m_direct.reset();
+  m_buffer.clear();
+}
+
+memory_cptr
+frame_sync_buffer_c::get_frame_data(size_t offset,
+                                    size_t size) {
+  if (m_direct && size)
+    return memory_c::slice(m_direct, offset, size);
+
+  return memory_c::clone(m_buffer.get_buffer() + offset, size);
+}
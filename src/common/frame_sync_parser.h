@@ -0,0 +1,117 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit http://www.gnu.org/copyleft/gpl.html
+
+   class definitions for the common base of the audio frame parsers
+
+   Written by Moritz Bunkus <moritz@bunkus.org>.
+*/
+
+#ifndef MTX_COMMON_FRAME_SYNC_PARSER_H
+#define MTX_COMMON_FRAME_SYNC_PARSER_H
+
+#include "common/common_pch.h"
+
+#include "common/byte_buffer.h"
+
+namespace mtx { namespace frame_sync {
+
+size_t find_sync_word(unsigned char const *buffer, size_t buffer_size, unsigned char first_byte, unsigned char second_byte, unsigned char second_byte_mask = 0xff);
+
+}}
+
+/* Input buffer for the frame parsers. Data added as a memory_cptr
+   that owns its memory is referenced instead of being copied as long
+   as no unparsed bytes are left over from earlier calls. Frames found
+   in such data are handed out as slices of it. Everything else is
+   copied into a byte_buffer_c as before. */
+
+class frame_sync_buffer_c {
+protected:
+  byte_buffer_c m_buffer;
+  memory_cptr m_direct;
+
+public:
+  void add(memory_cptr const &mem);
+  void add(unsigned char const *buffer, size_t size);
+  void remove(size_t num);
+  void clear();
+
+  memory_cptr get_frame_data(size_t offset, size_t size);
+
+  unsigned char *get_buffer() {
+    return m_direct ? m_direct->get_buffer() : m_buffer.get_buffer();
+  }
+
+  size_t get_size() {
+    return m_direct ? m_direct->get_size() : m_buffer.get_size();
+  }
+};
+
+/* Common state of the parsers for audio elementary streams that
+   consist of frames starting with a sync word: the input buffer, the
+   queue of frames found and the stream positions. Derived classes
+   implement parse_buffer(). */
+
+template<typename Tframe>
+class frame_sync_parser_c {
+protected:
+  frame_sync_buffer_c m_buffer;
+  std::deque<Tframe> m_frames;
+  uint64_t m_parsed_stream_position, m_total_stream_position;
+  size_t m_garbage_size;
+
+public:
+  frame_sync_parser_c()
+    : m_parsed_stream_position{}
+    , m_total_stream_position{}
+    , m_garbage_size{}
+  {
+  }
+
+  virtual ~frame_sync_parser_c() {
+  }
+
+  void add_bytes(memory_cptr const &mem) {
+    m_buffer.add(mem);
+    m_total_stream_position += mem->get_size();
+    parse_buffer(false);
+  }
+
+  void add_bytes(unsigned char const *buffer, size_t size) {
+    m_buffer.add(buffer, size);
+    m_total_stream_position += size;
+    parse_buffer(false);
+  }
+
+  void flush() {
+    parse_buffer(true);
+  }
+
+  size_t frames_available() const {
+    return m_frames.size();
+  }
+
+  uint64_t get_parsed_stream_position() const {
+    return m_parsed_stream_position;
+  }
+
+  uint64_t get_total_stream_position() const {
+    return m_total_stream_position;
+  }
+
+protected:
+  virtual void parse_buffer(bool end_of_stream) = 0;
+
+  Tframe pop_frame() {
+    auto frame = m_frames.front();
+    m_frames.pop_front();
+    return frame;
+  }
+};
+
+#endif // MTX_COMMON_FRAME_SYNC_PARSER_H
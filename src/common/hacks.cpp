@@ -40,6 +40,7 @@ static const struct {
   { ENGAGE_NO_CUE_DURATION,              "no_cue_duration"              },
   { ENGAGE_NO_CUE_RELATIVE_POSITION,     "no_cue_relative_position"     },
   { ENGAGE_NO_DELAY_FOR_GARBAGE_IN_AVI,  "no_delay_for_garbage_in_avi"  },
+  { ENGAGE_REGEX_TEXT_SUBTITLE_PARSERS,  "regex_text_subtitle_parsers"  },
   { 0,                                   nullptr },
 };
 static std::vector<bool> s_engaged_hacks(ENGAGE_MAX_IDX + 1, false);
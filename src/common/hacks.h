@@ -37,7 +37,8 @@
 #define ENGAGE_NO_CUE_DURATION              16
 #define ENGAGE_NO_CUE_RELATIVE_POSITION     17
 #define ENGAGE_NO_DELAY_FOR_GARBAGE_IN_AVI  18
-#define ENGAGE_MAX_IDX                      18
+#define ENGAGE_REGEX_TEXT_SUBTITLE_PARSERS  19
+#define ENGAGE_MAX_IDX                      19
 
 void engage_hacks(const std::string &hacks);
 void engage_hack(unsigned int id);
@@ -19,6 +19,7 @@
 #include "common/common_pch.h"
 
 #include <cmath>
+#include <numeric>
 #include <unordered_map>
 
 #include "common/bit_cursor.h"
@@ -28,6 +29,8 @@
 #include "common/hacks.h"
 #include "common/mm_io.h"
 #include "common/hevc.h"
+#include "common/rbsp.h"
+#include "common/sorting.h"
 #include "common/strings/formatting.h"
 
 namespace mtx { namespace hevc {
@@ -948,47 +951,12 @@ slice_info_t::dump()
 
 void
 nalu_to_rbsp(memory_cptr &buffer) {
-  int pos, size = buffer->get_size();
-  mm_mem_io_c d(nullptr, size, 100);
-  unsigned char *b = buffer->get_buffer();
-
-  for (pos = 0; pos < size; ++pos) {
-    if (   ((pos + 2) < size)
-        && (0 == b[pos])
-        && (0 == b[pos + 1])
-        && (3 == b[pos + 2])) {
-      d.write_uint8(0);
-      d.write_uint8(0);
-      pos += 2;
-
-    } else
-      d.write_uint8(b[pos]);
-  }
-
-  buffer = memory_cptr(new memory_c(d.get_and_lock_buffer(), d.getFilePointer(), true));
+  buffer = mtx::rbsp::nalu_to_rbsp(buffer);
 }
 
 void
 rbsp_to_nalu(memory_cptr &buffer) {
-  int pos, size = buffer->get_size();
-  mm_mem_io_c d(nullptr, size, 100);
-  unsigned char *b = buffer->get_buffer();
-
-  for (pos = 0; pos < size; ++pos) {
-    if (   ((pos + 2) < size)
-        && (0 == b[pos])
-        && (0 == b[pos + 1])
-        && (3 >= b[pos + 2])) {
-      d.write_uint8(0);
-      d.write_uint8(0);
-      d.write_uint8(3);
-      ++pos;
-
-    } else
-      d.write_uint8(b[pos]);
-  }
-
-  buffer = memory_cptr(new memory_c(d.get_and_lock_buffer(), d.getFilePointer(), true));
+  buffer = mtx::rbsp::rbsp_to_nalu(buffer);
 }
 
 bool
@@ -1647,7 +1615,7 @@ es_parser_c::flush() {
 
 void
 es_parser_c::add_timecode(int64_t timecode) {
-  m_provided_timecodes.push_back(timecode);
+  mtx::sort::insert_nearly_sorted(m_provided_timecodes, timecode);
   m_provided_stream_positions.push_back(m_stream_position);
   ++m_stats.num_timecodes_in;
 }
@@ -2009,7 +1977,11 @@ bool
 es_parser_c::parse_slice(memory_cptr &buffer,
                          slice_info_t &si) {
   try {
-    bit_reader_c r(buffer->get_buffer(), buffer->get_size());
+    // Emulation prevention bytes are only removed from the part the
+    // slice header can occupy.
+    unsigned char rbsp[mtx::rbsp::slice_header_prefix_size];
+    auto rbsp_size = mtx::rbsp::nalu_to_rbsp(buffer->get_buffer(), buffer->get_size(), rbsp, sizeof(rbsp));
+    bit_reader_c r(rbsp, rbsp_size);
     unsigned int i;
 
     memset(&si, 0, sizeof(si));
@@ -2212,50 +2184,48 @@ es_parser_c::cleanup() {
     ++idx;
   }
 
-  if (!simple_picture_order)
-    brng::sort(m_frames, [](const frame_t &f1, const frame_t &f2) { return f1.m_presentation_order < f2.m_presentation_order; });
+  // Frames are kept in decode order; only their indexes are brought
+  // into presentation order for assigning the timestamps.
+  m_presentation_order_indexes.resize(m_frames.size());
+  std::iota(m_presentation_order_indexes.begin(), m_presentation_order_indexes.end(), 0);
 
-  brng::sort(m_provided_timecodes);
+  if (!simple_picture_order)
+    mtx::sort::nearly_sorted(m_presentation_order_indexes.begin(), m_presentation_order_indexes.end(), [this](size_t idx1, size_t idx2) {
+      return m_frames[idx1].m_presentation_order < m_frames[idx2].m_presentation_order;
+    });
 
-  frames_begin               = m_frames.begin();
-  frames_end                 = m_frames.end();
-  auto previous_frame_itr    = frames_begin;
   auto provided_timecode_itr = m_provided_timecodes.begin();
-  for (frame_itr = frames_begin; frames_end != frame_itr; ++frame_itr) {
-    if (frame_itr->m_has_provided_timecode) {
-      frame_itr->m_start = *provided_timecode_itr;
+  frame_t *previous_frame    = nullptr;
+
+  for (auto idx : m_presentation_order_indexes) {
+    auto &frame = m_frames[idx];
+
+    if (frame.m_has_provided_timecode) {
+      frame.m_start = *provided_timecode_itr;
       ++provided_timecode_itr;
 
-      if (frames_begin != frame_itr)
-        previous_frame_itr->m_end = frame_itr->m_start;
+      if (previous_frame)
+        previous_frame->m_end = frame.m_start;
 
     } else {
-      frame_itr->m_start = frames_begin == frame_itr ? m_max_timecode : previous_frame_itr->m_end;
+      frame.m_start = !previous_frame ? m_max_timecode : previous_frame->m_end;
       ++m_stats.num_timecodes_generated;
     }
 
-    if (frame_itr->m_start == 1033333333)
-      mxinfo("muh\n");
-    frame_itr->m_end = frame_itr->m_start + duration_for(frame_itr->m_si);
-
-    previous_frame_itr = frame_itr;
+    frame.m_end    = frame.m_start + duration_for(frame.m_si);
+    previous_frame = &frame;
   }
 
-  m_max_timecode = m_frames.back().m_end;
+  m_max_timecode = previous_frame->m_end;
   m_provided_timecodes.erase(m_provided_timecodes.begin(), provided_timecode_itr);
 
   mxdebug_if(m_debug_timecodes, boost::format("CLEANUP frames <pres_ord dec_ord has_prov_tc tc dur>: %1%\n")
-             % boost::accumulate(m_frames, std::string(""), [](std::string const &accu, frame_t const &frame) {
+             % boost::accumulate(m_presentation_order_indexes, std::string(""), [this](std::string const &accu, size_t idx) {
+                 auto const &frame = m_frames[idx];
                  return accu + (boost::format(" <%1% %2% %3% %4% %5%>") % frame.m_presentation_order % frame.m_decode_order % frame.m_has_provided_timecode % frame.m_start % (frame.m_end - frame.m_start)).str();
                }));
 
-
-  if (!simple_picture_order)
-    brng::sort(m_frames, [](const frame_t &f1, const frame_t &f2) { return f1.m_decode_order < f2.m_decode_order; });
-
-  frames_begin       = m_frames.begin();
-  frames_end         = m_frames.end();
-  previous_frame_itr = frames_begin;
+  auto previous_frame_itr = frames_begin;
   for (frame_itr = frames_begin; frames_end != frame_itr; ++frame_itr) {
     if (frames_begin != frame_itr)
       frame_itr->m_ref1 = previous_frame_itr->m_start - frame_itr->m_start;
@@ -464,7 +464,9 @@ protected:
   bool m_par_found;
   int64_rational_c m_par;
 
-  std::deque<frame_t> m_frames, m_frames_out;
+  std::vector<frame_t> m_frames;
+  std::deque<frame_t> m_frames_out;
+  std::vector<size_t> m_presentation_order_indexes;
   std::deque<int64_t> m_provided_timecodes;
   std::deque<uint64_t> m_provided_stream_positions;
   int64_t m_max_timecode;
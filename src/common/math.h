@@ -31,6 +31,20 @@ count_1_bits(uint64_t value) {
 #endif
 }
 
+inline std::size_t
+count_leading_zero_bits(uint64_t value) {
+  if (!value)
+    return 64;
+
+#if defined(COMP_MSC)
+  unsigned long index;
+  _BitScanReverse64(&index, value);
+  return 63 - index;
+#else
+  return __builtin_clzll(value);
+#endif
+}
+
 uint64_t round_to_nearest_pow2(uint64_t value);
 int int_log2(uint64_t value);
 double int_to_double(int64_t value);
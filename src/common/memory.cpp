@@ -33,9 +33,30 @@ memory_c::resize(size_t new_size)
     its_counter->ptr     = tmp;
     its_counter->is_free = true;
     its_counter->size    = new_size;
+    its_counter->parent.reset();
   }
 }
 
+/** \brief Create a view into another memory buffer without copying it
+
+   The returned buffer keeps \c parent alive for as long as it
+   exists. \c grab() considers such a view to be owned memory. \c
+   parent itself is made to own its memory first if it doesn't already.
+*/
+memory_cptr
+memory_c::slice(memory_cptr const &parent,
+                size_t offset,
+                size_t size) {
+  assert(size && ((offset + size) <= parent->get_size()));
+
+  parent->grab();
+
+  auto view                 = std::make_shared<memory_c>(parent->get_buffer() + offset, size, false);
+  view->its_counter->parent = parent;
+
+  return view;
+}
+
 void
 memory_c::add(unsigned char const *new_buffer,
               size_t new_size) {
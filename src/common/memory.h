@@ -126,6 +126,10 @@ public:
       its_counter->size = new_size;
   }
 
+  size_t get_offset() const {
+    return its_counter ? its_counter->offset : 0;
+  }
+
   void set_offset(size_t new_offset) {
     if (!its_counter || (new_offset > its_counter->size))
       throw false;
@@ -149,7 +153,7 @@ public:
   }
 
   void grab() {
-    if (!its_counter || its_counter->is_free)
+    if (!its_counter || its_counter->is_free || its_counter->parent)
       return;
 
     its_counter->ptr      = static_cast<unsigned char *>(safememdup(get_buffer(), get_size()));
@@ -217,6 +221,8 @@ public:
     return std::make_shared<memory_c>(reinterpret_cast<unsigned char *>(&buffer[0]), buffer.length(), false);
   }
 
+  static memory_cptr slice(memory_cptr const &parent, size_t offset, size_t size);
+
 private:
   struct counter {
     unsigned char *ptr;
@@ -224,6 +230,7 @@ private:
     bool is_free;
     unsigned count;
     size_t offset;
+    memory_cptr parent;
 
     counter(unsigned char *p = nullptr,
             size_t s = 0,
@@ -15,6 +15,9 @@
 #include "common/common_pch.h"
 
 #include <errno.h>
+#if defined(HAVE_FCNTL_H)
+# include <fcntl.h>
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #ifdef HAVE_UNISTD_H
@@ -36,6 +39,10 @@ union double_to_uint64_t {
   double d;
 };
 
+bool mm_file_io_c::ms_drop_output_from_cache = false;
+bool mm_file_io_c::ms_drop_input_from_cache  = false;
+std::atomic<uint64_t> mm_file_io_c::ms_num_bytes_read{};
+
 #if !defined(SYS_WINDOWS)
 mm_file_io_c::mm_file_io_c(const std::string &path,
                            const open_mode mode)
@@ -73,6 +80,14 @@ mm_file_io_c::mm_file_io_c(const std::string &path,
 
   if (!m_file)
     throw mtx::mm_io::open_x{mtx::mm_io::make_error_code()};
+
+  m_drop_written_data = ms_drop_output_from_cache && ((MODE_WRITE == mode) || (MODE_CREATE == mode));
+  m_drop_read_data    = ms_drop_input_from_cache  && ((MODE_READ  == mode) || (MODE_SAFE   == mode));
+
+#if defined(HAVE_POSIX_FADVISE)
+  if (m_drop_read_data)
+    posix_fadvise(fileno((FILE *)m_file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
 }
 
 void
@@ -98,25 +113,192 @@ mm_file_io_c::_write(const void *buffer,
   m_current_position += bwritten;
   m_cached_size       = -1;
 
+  if (m_drop_written_data)
+    track_written_range(m_current_position - bwritten, m_current_position);
+
   return bwritten;
 }
 
+/* Dropping written data from the page cache
+
+   Huge output files would otherwise push everything else out of the
+   page cache, including the input files. Written data is collected
+   in contiguous ranges. Once a range is big enough its writeback is
+   started. The previous range is then waited for and dropped from the
+   cache so that writing and writeback overlap.
+*/
+
+static int64_t const s_drop_behind_range_size = 16 * 1024 * 1024;
+static int64_t const s_page_size              = 4096;
+
+void
+mm_file_io_c::track_written_range(int64_t start,
+                                  int64_t end) {
+  if (start != m_dirty_end) {
+    write_back_dirty_range();
+    m_dirty_start = start;
+  }
+
+  m_dirty_end = end;
+
+  if ((m_dirty_end - m_dirty_start) >= s_drop_behind_range_size)
+    write_back_dirty_range();
+}
+
+void
+mm_file_io_c::write_back_dirty_range() {
+  if (m_dirty_start == m_dirty_end)
+    return;
+
+#if defined(HAVE_POSIX_FADVISE)
+  auto file = static_cast<FILE *>(m_file);
+  auto fd   = fileno(file);
+
+  fflush(file);
+
+  // Round down to the page boundary so that the partial page left
+  // over by the previous range is dropped as well.
+  auto start = m_dirty_start - (m_dirty_start % s_page_size);
+
+# if defined(HAVE_SYNC_FILE_RANGE)
+  sync_file_range(fd, start, m_dirty_end - start, SYNC_FILE_RANGE_WRITE);
+
+  if (m_writeback_start != m_writeback_end) {
+    sync_file_range(fd, m_writeback_start, m_writeback_end - m_writeback_start, SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+    posix_fadvise(fd, m_writeback_start, m_writeback_end - m_writeback_start, POSIX_FADV_DONTNEED);
+  }
+
+  m_writeback_start = start;
+  m_writeback_end   = m_dirty_end;
+
+# else  // HAVE_SYNC_FILE_RANGE
+  fdatasync(fd);
+  posix_fadvise(fd, start, m_dirty_end - start, POSIX_FADV_DONTNEED);
+# endif  // HAVE_SYNC_FILE_RANGE
+#endif  // HAVE_POSIX_FADVISE
+
+  m_dirty_start = m_dirty_end;
+}
+
+void
+mm_file_io_c::drop_written_data_on_close() {
+#if defined(HAVE_POSIX_FADVISE)
+  auto file = static_cast<FILE *>(m_file);
+  auto fd   = fileno(file);
+
+  fflush(file);
+
+  // Don't wait for the writeback here. Pages that are still dirty
+  // simply stay in the cache.
+  posix_fadvise(fd, m_writeback_start, m_writeback_end - m_writeback_start, POSIX_FADV_DONTNEED);
+  posix_fadvise(fd, m_dirty_start,     m_dirty_end     - m_dirty_start,     POSIX_FADV_DONTNEED);
+#endif  // HAVE_POSIX_FADVISE
+
+  m_dirty_start     = 0;
+  m_dirty_end       = 0;
+  m_writeback_start = 0;
+  m_writeback_end   = 0;
+}
+
+/** \brief Reserves disk space for the file
+
+   Reserving the space up front avoids fragmenting the file system
+   with huge output files. The file's size is not changed. Space
+   beyond the final size is released again in \c close().
+*/
+void
+mm_file_io_c::preallocate(int64_t size) {
+#if defined(HAVE_FALLOCATE) && defined(FALLOC_FL_KEEP_SIZE)
+  if (!m_file || (0 >= size))
+    return;
+
+  auto file = static_cast<FILE *>(m_file);
+
+  fflush(file);
+  if (0 == fallocate(fileno(file), FALLOC_FL_KEEP_SIZE, 0, size))
+    m_preallocated = true;
+
+#else
+  (void)size;
+#endif
+}
+
 uint32
 mm_file_io_c::_read(void *buffer,
                     size_t size) {
   int64_t bread = fread(buffer, 1, size, (FILE *)m_file);
 
+  if (m_drop_read_data)
+    track_read_range(m_current_position, m_current_position + bread);
+
   m_current_position += bread;
+  ms_num_bytes_read  += bread;
 
   return bread;
 }
 
+/* Dropping consumed input from the page cache
+
+   Works like dropping written data: contiguous ranges of data that
+   has been read are dropped once they're big enough. Readers that
+   jump around, e.g. for non-interleaved MP4 files, produce many
+   small ranges. Those are dropped when the reader jumps elsewhere
+   unless they're too small to be worth a system call.
+*/
+
+static int64_t const s_min_consumed_range_size = 64 * 1024;
+
+void
+mm_file_io_c::track_read_range(int64_t start,
+                               int64_t end) {
+  if (start != m_consumed_end) {
+    if ((m_consumed_end - m_consumed_start) >= s_min_consumed_range_size)
+      drop_consumed_range();
+    m_consumed_start = start;
+  }
+
+  m_consumed_end = end;
+
+  if ((m_consumed_end - m_consumed_start) >= s_drop_behind_range_size)
+    drop_consumed_range();
+}
+
+void
+mm_file_io_c::drop_consumed_range() {
+#if defined(HAVE_POSIX_FADVISE)
+  auto start = m_consumed_start - (m_consumed_start % s_page_size);
+  posix_fadvise(fileno((FILE *)m_file), start, m_consumed_end - start, POSIX_FADV_DONTNEED);
+#endif
+
+  m_consumed_start = m_consumed_end;
+}
+
 void
 mm_file_io_c::close() {
-  if (m_file) {
-    fclose((FILE *)m_file);
-    m_file = nullptr;
+  if (!m_file)
+    return;
+
+  if (m_drop_written_data)
+    drop_written_data_on_close();
+
+  if (m_drop_read_data)
+    drop_consumed_range();
+
+  if (m_preallocated) {
+    // Truncating to the current size releases the reserved space
+    // that hasn't been used.
+    struct stat st;
+
+    fflush((FILE *)m_file);
+    if (   (0 != fstat(fileno((FILE *)m_file), &st))
+        || (0 != ftruncate(fileno((FILE *)m_file), st.st_size)))
+      mxwarn(boost::format(Y("The disk space reserved for '%1%' but not used could not be released: %2% (%3%).\n")) % m_file_name % strerror(errno) % errno);
+
+    m_preallocated = false;
   }
+
+  fclose((FILE *)m_file);
+  m_file = nullptr;
 }
 
 bool
@@ -515,6 +697,30 @@ mm_io_c::write(const memory_cptr &buffer,
   return size;
 }
 
+/** \brief Writes several buffers in one go ("gather write")
+
+   The default implementation writes the buffers one after the
+   other. Classes that can do better, e.g. by copying all of them into
+   their buffer at once, override this.
+
+   \return The number of bytes written. Writing stops at the first
+   buffer that could not be written completely.
+*/
+size_t
+mm_io_c::writev(mm_io_vecs_t const &vectors) {
+  auto total = size_t{};
+
+  for (auto const &vector : vectors) {
+    auto written  = write(vector.buffer, vector.size);
+    total        += written;
+
+    if (written != vector.size)
+      break;
+  }
+
+  return total;
+}
+
 void
 mm_io_c::skip(int64 num_bytes) {
   uint64_t pos = getFilePointer();
@@ -874,6 +1080,9 @@ mm_text_io_c::mm_text_io_c(mm_io_c *in,
   , m_uses_carriage_returns(false)
   , m_uses_newlines(false)
   , m_eol_style_detected(false)
+  , m_buffer_pos{}
+  , m_buffer_fill{}
+  , m_proxy_size{-1}
 {
   in->setFilePointer(0, seek_beginning);
 
@@ -955,10 +1164,51 @@ mm_text_io_c::has_byte_order_marker(const std::string &string) {
   return detect_byte_order_marker(reinterpret_cast<const unsigned char *>(string.c_str()), string.length(), byte_order, bom_length);
 }
 
+namespace {
+
 // 1 byte: 0xxxxxxx,
 // 2 bytes: 110xxxxx 10xxxxxx,
 // 3 bytes: 1110xxxx 10xxxxxx 10xxxxxx
 
+inline size_t
+utf8_sequence_length(unsigned char first_byte) {
+  return ((first_byte & 0x80) == 0x00) ?  1
+       : ((first_byte & 0xe0) == 0xc0) ?  2
+       : ((first_byte & 0xf0) == 0xe0) ?  3
+       : ((first_byte & 0xf8) == 0xf0) ?  4
+       : ((first_byte & 0xfc) == 0xf8) ?  5
+       : ((first_byte & 0xfe) == 0xfc) ?  6
+       :                                 99;
+}
+
+int
+encode_utf8(unsigned long data,
+            char *buffer) {
+  if (data < 0x80) {
+    buffer[0] = data;
+    return 1;
+  }
+
+  if (data < 0x800) {
+    buffer[0] = 0xc0 | (data >> 6);
+    buffer[1] = 0x80 | (data & 0x3f);
+    return 2;
+  }
+
+  if (data < 0x10000) {
+    buffer[0] = 0xe0 |  (data >> 12);
+    buffer[1] = 0x80 | ((data >> 6) & 0x3f);
+    buffer[2] = 0x80 |  (data       & 0x3f);
+    return 3;
+  }
+
+  mxerror(Y("mm_text_io_c: UTF32_* is not supported at the moment.\n"));
+
+  return 0;
+}
+
+}
+
 int
 mm_text_io_c::read_next_char(char *buffer) {
   if (BO_NONE == m_byte_order)
@@ -970,13 +1220,7 @@ mm_text_io_c::read_next_char(char *buffer) {
     if (read(stream, 1) != 1)
       return 0;
 
-    size = ((stream[0] & 0x80) == 0x00) ?  1
-         : ((stream[0] & 0xe0) == 0xc0) ?  2
-         : ((stream[0] & 0xf0) == 0xe0) ?  3
-         : ((stream[0] & 0xf8) == 0xf0) ?  4
-         : ((stream[0] & 0xfc) == 0xf8) ?  5
-         : ((stream[0] & 0xfe) == 0xfc) ?  6
-         :                                99;
+    size = utf8_sequence_length(stream[0]);
 
     if (99 == size)
       throw mtx::mm_io::text::invalid_utf8_char_x(stream[0]);
@@ -988,10 +1232,9 @@ mm_text_io_c::read_next_char(char *buffer) {
 
     return size;
 
-  } else if ((BO_UTF16_LE == m_byte_order) || (BO_UTF16_BE == m_byte_order))
-    size = 2;
-  else
-    size = 4;
+  }
+
+  size = get_code_unit_size();
 
   if (read(stream, size) != size)
     return 0;
@@ -1004,27 +1247,149 @@ mm_text_io_c::read_next_char(char *buffer) {
     shift += little_endian ? 8 : -8;
   }
 
-  if (data < 0x80) {
-    buffer[0] = data;
-    return 1;
+  return encode_utf8(data, buffer);
+}
+
+unsigned int
+mm_text_io_c::get_code_unit_size()
+  const {
+  return (BO_UTF16_LE == m_byte_order) || (BO_UTF16_BE == m_byte_order) ? 2
+       : (BO_UTF32_LE == m_byte_order) || (BO_UTF32_BE == m_byte_order) ? 4
+       :                                                                   1;
+}
+
+// Makes sure that at least num_bytes are available in the read-ahead
+// buffer unless the end of the file is reached. Returns the number of
+// bytes available.
+size_t
+mm_text_io_c::ensure_buffered(size_t num_bytes) {
+  auto available = m_buffer_fill - m_buffer_pos;
+  if (available >= num_bytes)
+    return available;
+
+  if (!m_buffer)
+    m_buffer = memory_c::alloc(s_buffer_size);
+
+  auto buffer = m_buffer->get_buffer();
+  if (available && m_buffer_pos)
+    memmove(buffer, buffer + m_buffer_pos, available);
+
+  m_buffer_pos  = 0;
+  m_buffer_fill = available;
+
+  // The size is only determined once. Sources that cannot report it
+  // are read until a read returns less than requested.
+  if (-1 == m_proxy_size) {
+    try {
+      m_proxy_size = m_proxy_io->get_size();
+    } catch (mtx::mm_io::exception &) {
+      m_proxy_size = std::numeric_limits<int64_t>::max();
+    }
   }
 
-  if (data < 0x800) {
-    buffer[0] = 0xc0 | (data >> 6);
-    buffer[1] = 0x80 | (data & 0x3f);
-    return 2;
+  while (m_buffer_fill < num_bytes) {
+    // Don't read past the end of the file unless nothing is left so
+    // that eof() behaves the same as reading byte by byte would.
+    auto to_read   = s_buffer_size - m_buffer_fill;
+    auto remaining = m_proxy_size - static_cast<int64_t>(m_proxy_io->getFilePointer());
+    if (0 < remaining)
+      to_read = std::min<size_t>(to_read, remaining);
+
+    auto num_read  = m_proxy_io->read(buffer + m_buffer_fill, to_read);
+    m_buffer_fill += num_read;
+
+    if (num_read < to_read)
+      break;
   }
 
-  if (data < 0x10000) {
-    buffer[0] = 0xe0 |  (data >> 12);
-    buffer[1] = 0x80 | ((data >> 6) & 0x3f);
-    buffer[2] = 0x80 |  (data       & 0x3f);
-    return 3;
+  return m_buffer_fill;
+}
+
+unsigned long
+mm_text_io_c::peek_code_unit()
+  const {
+  auto stream = m_buffer->get_buffer() + m_buffer_pos;
+
+  switch (m_byte_order) {
+    case BO_UTF16_LE: return get_uint16_le(stream);
+    case BO_UTF16_BE: return get_uint16_be(stream);
+    case BO_UTF32_LE: return get_uint32_le(stream);
+    case BO_UTF32_BE: return get_uint32_be(stream);
+    default:          return stream[0];
   }
+}
 
-  mxerror(Y("mm_text_io_c: UTF32_* is not supported at the moment.\n"));
+// Appends everything up to but not including the next carriage return
+// or newline to s. The character at the current position must be
+// neither. Stops early at the end of the buffered data.
+void
+mm_text_io_c::append_until_eol(std::string &s) {
+  auto buffer = m_buffer->get_buffer();
+  auto start  = buffer + m_buffer_pos;
+  auto end    = buffer + m_buffer_fill;
+
+  if (BO_NONE == m_byte_order) {
+    // Searching for the newline first limits the search for carriage
+    // returns to the current line.
+    auto eol = static_cast<unsigned char *>(memchr(start, '\n', end - start));
+    eol      = eol ? eol : end;
+    auto cr  = static_cast<unsigned char *>(memchr(start, '\r', eol - start));
+    eol      = cr  ? cr  : eol;
+
+    s.append(reinterpret_cast<char *>(start), eol - start);
+    m_buffer_pos += eol - start;
 
-  return 0;
+    return;
+  }
+
+  if (BO_UTF8 == m_byte_order) {
+    auto ptr = start;
+    while ((ptr < end) && ('\r' != *ptr) && ('\n' != *ptr)) {
+      if (*ptr < 0x80) {
+        ++ptr;
+        continue;
+      }
+
+      auto size = utf8_sequence_length(*ptr);
+      if (99 == size)
+        throw mtx::mm_io::text::invalid_utf8_char_x(*ptr);
+
+      if (static_cast<size_t>(end - ptr) < size)
+        break;
+
+      ptr += size;
+    }
+
+    if (ptr != start) {
+      s.append(reinterpret_cast<char *>(start), ptr - start);
+      m_buffer_pos += ptr - start;
+      return;
+    }
+
+    // A multi-byte sequence crosses the end of the buffer.
+    auto size = utf8_sequence_length(*ptr);
+    if (ensure_buffered(size) < size) {
+      m_buffer_pos = m_buffer_fill;
+      return;
+    }
+
+    s.append(reinterpret_cast<char *>(m_buffer->get_buffer() + m_buffer_pos), size);
+    m_buffer_pos += size;
+
+    return;
+  }
+
+  auto unit_size = get_code_unit_size();
+  char utf8char[9];
+
+  while ((m_buffer_fill - m_buffer_pos) >= unit_size) {
+    auto data = peek_code_unit();
+    if (('\r' == data) || ('\n' == data))
+      break;
+
+    s.append(utf8char, encode_utf8(data, utf8char));
+    m_buffer_pos += unit_size;
+  }
 }
 
 std::string
@@ -1036,45 +1401,92 @@ mm_text_io_c::getline() {
     detect_eol_style();
 
   std::string s;
-  char utf8char[9];
   bool previous_was_carriage_return = false;
+  auto unit_size                    = get_code_unit_size();
 
   while (1) {
-    memset(utf8char, 0, 9);
-
-    int len = read_next_char(utf8char);
-    if (0 == len)
+    if (ensure_buffered(unit_size) < unit_size) {
+      m_buffer_pos = m_buffer_fill;
       return s;
+    }
+
+    auto data = peek_code_unit();
 
-    if ((1 == len) && (utf8char[0] == '\r')) {
-      if (previous_was_carriage_return && !m_uses_newlines) {
-        setFilePointer(-1, seek_current);
+    if ('\r' == data) {
+      if (previous_was_carriage_return && !m_uses_newlines)
         return s;
-      }
 
-      previous_was_carriage_return = true;
+      previous_was_carriage_return  = true;
+      m_buffer_pos                 += unit_size;
       continue;
     }
 
-    if ((1 == len) && (utf8char[0] == '\n') && (!m_uses_carriage_returns || previous_was_carriage_return))
+    if (('\n' == data) && (!m_uses_carriage_returns || previous_was_carriage_return)) {
+      m_buffer_pos += unit_size;
       return s;
+    }
 
-    if (previous_was_carriage_return) {
-      setFilePointer(-len, seek_current);
+    if (previous_was_carriage_return)
       return s;
+
+    if ('\n' == data) {
+      s            += '\n';
+      m_buffer_pos += unit_size;
+      continue;
     }
 
-    previous_was_carriage_return  = false;
-    s                            += utf8char;
+    append_until_eol(s);
   }
 }
 
+uint64
+mm_text_io_c::getFilePointer() {
+  return mm_proxy_io_c::getFilePointer() - (m_buffer_fill - m_buffer_pos);
+}
+
 void
 mm_text_io_c::setFilePointer(int64 offset,
                              seek_mode mode) {
+  if (seek_current == mode)
+    offset -= m_buffer_fill - m_buffer_pos;
+
+  m_buffer_pos  = 0;
+  m_buffer_fill = 0;
+
   mm_proxy_io_c::setFilePointer(((0 == offset) && (seek_beginning == mode)) ? m_bom_len : offset, mode);
 }
 
+bool
+mm_text_io_c::eof() {
+  return (m_buffer_pos == m_buffer_fill) && mm_proxy_io_c::eof();
+}
+
+uint32
+mm_text_io_c::_read(void *buffer,
+                    size_t size) {
+  auto num_buffered = std::min(size, m_buffer_fill - m_buffer_pos);
+  if (num_buffered) {
+    memcpy(buffer, m_buffer->get_buffer() + m_buffer_pos, num_buffered);
+    m_buffer_pos += num_buffered;
+  }
+
+  if (num_buffered == size)
+    return num_buffered;
+
+  return num_buffered + mm_proxy_io_c::_read(static_cast<unsigned char *>(buffer) + num_buffered, size - num_buffered);
+}
+
+size_t
+mm_text_io_c::_write(const void *buffer,
+                     size_t size) {
+  if (m_buffer_pos != m_buffer_fill)
+    setFilePointer(0, seek_current);
+
+  m_proxy_size = -1;
+
+  return mm_proxy_io_c::_write(buffer, size);
+}
+
 /*
    Class for reading from stdin & writing to stdout.
 */
@@ -16,6 +16,7 @@
 
 #include "common/common_pch.h"
 
+#include <atomic>
 #include <stack>
 
 #include <ebml/IOCallback.h>
@@ -28,6 +29,14 @@ using mm_io_cptr = std::shared_ptr<mm_io_c>;
 class charset_converter_c;
 using charset_converter_cptr = std::shared_ptr<charset_converter_c>;
 
+// One buffer for mm_io_c::writev(). The buffers must remain valid
+// until writev() returns.
+struct mm_io_vec_t {
+  void const *buffer;
+  size_t size;
+};
+using mm_io_vecs_t = std::vector<mm_io_vec_t>;
+
 class mm_io_c: public IOCallback {
 protected:
   bool m_dos_style_newlines, m_bom_written;
@@ -76,6 +85,7 @@ public:
   virtual size_t write(const void *buffer, size_t size);
   virtual size_t write(std::string const &buffer);
   virtual size_t write(const memory_cptr &buffer, size_t size = UINT_MAX, size_t offset = 0);
+  virtual size_t writev(mm_io_vecs_t const &vectors);
   virtual bool eof() = 0;
   virtual void clear_eof() { }
   virtual void flush() {
@@ -83,6 +93,8 @@ public:
   virtual int truncate(int64_t) {
     return 0;
   }
+  virtual void preallocate(int64_t) {
+  }
 
   virtual std::string get_file_name() const = 0;
 
@@ -120,9 +132,16 @@ protected:
 };
 
 class mm_file_io_c: public mm_io_c {
+public:
+  static bool ms_drop_output_from_cache, ms_drop_input_from_cache;
+  static std::atomic<uint64_t> ms_num_bytes_read;
+
 protected:
   std::string m_file_name;
   void *m_file;
+  bool m_drop_written_data{}, m_drop_read_data{}, m_preallocated{};
+  int64_t m_dirty_start{}, m_dirty_end{}, m_writeback_start{}, m_writeback_end{};
+  int64_t m_consumed_start{}, m_consumed_end{};
 
 #if defined(SYS_WINDOWS)
   bool m_eof;
@@ -149,6 +168,7 @@ public:
   }
 
   virtual int truncate(int64_t pos);
+  virtual void preallocate(int64_t size);
 
   static void setup();
   static void cleanup();
@@ -157,6 +177,12 @@ public:
 protected:
   virtual uint32 _read(void *buffer, size_t size);
   virtual size_t _write(const void *buffer, size_t size);
+
+  void track_written_range(int64_t start, int64_t end);
+  void write_back_dirty_range();
+  void drop_written_data_on_close();
+  void track_read_range(int64_t start, int64_t end);
+  void drop_consumed_range();
 };
 
 using mm_file_io_cptr = std::shared_ptr<mm_file_io_c>;
@@ -195,6 +221,9 @@ public:
   virtual mm_io_c *get_proxied() const {
     return m_proxy_io;
   }
+  virtual void preallocate(int64_t size) {
+    m_proxy_io->preallocate(size);
+  }
 
 protected:
   virtual uint32 _read(void *buffer, size_t size);
@@ -263,15 +292,23 @@ using mm_mem_io_cptr = std::shared_ptr<mm_mem_io_c>;
 enum byte_order_e {BO_UTF8, BO_UTF16_LE, BO_UTF16_BE, BO_UTF32_LE, BO_UTF32_BE, BO_NONE};
 
 class mm_text_io_c: public mm_proxy_io_c {
+public:
+  static size_t const s_buffer_size = 64 * 1024;
+
 protected:
   byte_order_e m_byte_order;
   unsigned int m_bom_len;
   bool m_uses_carriage_returns, m_uses_newlines, m_eol_style_detected;
+  memory_cptr m_buffer;
+  size_t m_buffer_pos, m_buffer_fill;
+  int64_t m_proxy_size;
 
 public:
   mm_text_io_c(mm_io_c *in, bool delete_in = true);
 
+  virtual uint64 getFilePointer();
   virtual void setFilePointer(int64 offset, seek_mode mode=seek_beginning);
+  virtual bool eof();
   virtual std::string getline();
   virtual int read_next_char(char *buffer);
   virtual byte_order_e get_byte_order() const {
@@ -286,6 +323,13 @@ public:
 
 protected:
   virtual void detect_eol_style();
+  virtual uint32 _read(void *buffer, size_t size);
+  virtual size_t _write(const void *buffer, size_t size);
+
+  size_t ensure_buffered(size_t num_bytes);
+  unsigned int get_code_unit_size() const;
+  unsigned long peek_code_unit() const;
+  void append_until_eol(std::string &s);
 
 public:
   static bool has_byte_order_marker(const std::string &string);
@@ -144,6 +144,7 @@ mm_file_io_c::_read(void *buffer,
 
   m_eof               = size != bytes_read;
   m_current_position += bytes_read;
+  ms_num_bytes_read  += bytes_read;
 
   return bytes_read;
 }
@@ -215,6 +216,10 @@ mm_file_io_c::truncate(int64_t pos) {
   return -1;
 }
 
+void
+mm_file_io_c::preallocate(int64_t) {
+}
+
 void
 mm_file_io_c::setup() {
 }
@@ -122,6 +122,26 @@ mm_write_buffer_io_c::_write(const void *buffer,
   return size;
 }
 
+size_t
+mm_write_buffer_io_c::writev(mm_io_vecs_t const &vectors) {
+  auto total = size_t{};
+
+  // Small buffers are copied into the write buffer directly. Only
+  // those that don't fit go through _write() which flushes as needed.
+  for (auto const &vector : vectors) {
+    if (vector.size <= (m_size - m_fill)) {
+      memcpy(m_buffer + m_fill, vector.buffer, vector.size);
+      m_fill += vector.size;
+
+    } else
+      _write(vector.buffer, vector.size);
+
+    total += vector.size;
+  }
+
+  return total;
+}
+
 void
 mm_write_buffer_io_c::flush_buffer() {
   if (!m_fill)
@@ -36,6 +36,7 @@ public:
   virtual void flush();
   virtual void close();
   virtual void discard_buffer();
+  virtual size_t writev(mm_io_vecs_t const &vectors);
 
   static mm_io_cptr open(const std::string &file_name, size_t buffer_size);
 
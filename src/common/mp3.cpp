@@ -134,6 +134,11 @@ find_mp3_header(const unsigned char *buf,
     return -1;
 
   for (pos = 0; pos < (size - 4); pos++) {
+    // Only ID3 tags, TAG tags and frame headers are of interest. Skip
+    // everything else without looking at it any further.
+    if ((buf[pos] != 0xff) && (buf[pos] != 'I') && (buf[pos] != 'T'))
+      continue;
+
     if ((buf[pos] == 'I') && (buf[pos + 1] == 'D') && (buf[pos + 2] == '3')) {
       if ((pos + 10) >= size)
         return -1;
@@ -20,6 +20,7 @@
 #include "common/common_pch.h"
 
 #include <cmath>
+#include <numeric>
 #include <unordered_map>
 
 #include "common/bit_cursor.h"
@@ -29,6 +30,8 @@
 #include "common/hacks.h"
 #include "common/mm_io.h"
 #include "common/mpeg4_p10.h"
+#include "common/rbsp.h"
+#include "common/sorting.h"
 #include "common/strings/formatting.h"
 
 namespace mpeg4 {
@@ -429,47 +432,12 @@ mpeg4::p10::slice_info_t::dump()
 
 void
 mpeg4::p10::nalu_to_rbsp(memory_cptr &buffer) {
-  int pos, size = buffer->get_size();
-  mm_mem_io_c d(nullptr, size, 100);
-  unsigned char *b = buffer->get_buffer();
-
-  for (pos = 0; pos < size; ++pos) {
-    if (   ((pos + 2) < size)
-        && (0 == b[pos])
-        && (0 == b[pos + 1])
-        && (3 == b[pos + 2])) {
-      d.write_uint8(0);
-      d.write_uint8(0);
-      pos += 2;
-
-    } else
-      d.write_uint8(b[pos]);
-  }
-
-  buffer = memory_cptr(new memory_c(d.get_and_lock_buffer(), d.getFilePointer(), true));
+  buffer = mtx::rbsp::nalu_to_rbsp(buffer);
 }
 
 void
 mpeg4::p10::rbsp_to_nalu(memory_cptr &buffer) {
-  int pos, size = buffer->get_size();
-  mm_mem_io_c d(nullptr, size, 100);
-  unsigned char *b = buffer->get_buffer();
-
-  for (pos = 0; pos < size; ++pos) {
-    if (   ((pos + 2) < size)
-        && (0 == b[pos])
-        && (0 == b[pos + 1])
-        && (3 >= b[pos + 2])) {
-      d.write_uint8(0);
-      d.write_uint8(0);
-      d.write_uint8(3);
-      ++pos;
-
-    } else
-      d.write_uint8(b[pos]);
-  }
-
-  buffer = memory_cptr(new memory_c(d.get_and_lock_buffer(), d.getFilePointer(), true));
+  buffer = mtx::rbsp::rbsp_to_nalu(buffer);
 }
 
 bool
@@ -1097,7 +1065,7 @@ mpeg4::p10::avc_es_parser_c::flush() {
 
 void
 mpeg4::p10::avc_es_parser_c::add_timecode(int64_t timecode) {
-  m_provided_timecodes.push_back(timecode);
+  mtx::sort::insert_nearly_sorted(m_provided_timecodes, timecode);
   m_provided_stream_positions.push_back(m_stream_position);
   ++m_stats.num_timecodes_in;
 }
@@ -1422,7 +1390,11 @@ bool
 mpeg4::p10::avc_es_parser_c::parse_slice(memory_cptr &buffer,
                                          slice_info_t &si) {
   try {
-    bit_reader_c r(buffer->get_buffer(), buffer->get_size());
+    // Only the start of the slice header is parsed. Converting just
+    // that part keeps the effort independent of the slice's size.
+    unsigned char rbsp[mtx::rbsp::slice_header_prefix_size];
+    auto rbsp_size = mtx::rbsp::nalu_to_rbsp(buffer->get_buffer(), buffer->get_size(), rbsp, sizeof(rbsp));
+    bit_reader_c r(rbsp, rbsp_size);
 
     memset(&si, 0, sizeof(si));
 
@@ -1631,50 +1603,51 @@ mpeg4::p10::avc_es_parser_c::cleanup() {
 
   calculate_frame_order();
 
-  if (!m_simple_picture_order && !s_debug_force_simple_picture_order)
-    brng::sort(m_frames, [](const avc_frame_t &f1, const avc_frame_t &f2) { return f1.m_presentation_order < f2.m_presentation_order; });
+  // The frames stay in decode order. Timestamps are assigned in
+  // presentation order by walking through their indexes sorted by
+  // the picture order count. A frame is never further away from its
+  // presentation position than the reorder depth allows.
+  m_presentation_order_indexes.resize(m_frames.size());
+  std::iota(m_presentation_order_indexes.begin(), m_presentation_order_indexes.end(), 0);
 
-  brng::sort(m_provided_timecodes);
+  if (!m_simple_picture_order && !s_debug_force_simple_picture_order)
+    mtx::sort::nearly_sorted(m_presentation_order_indexes.begin(), m_presentation_order_indexes.end(), [this](size_t idx1, size_t idx2) {
+      return m_frames[idx1].m_presentation_order < m_frames[idx2].m_presentation_order;
+    });
 
-  auto frames_begin          = m_frames.begin();
-  auto frames_end            = m_frames.end();
-  auto frame_itr             = frames_begin;
-  auto previous_frame_itr    = frames_begin;
   auto provided_timecode_itr = m_provided_timecodes.begin();
+  avc_frame_t *previous_frame = nullptr;
 
-  while (frames_end != frame_itr) {
-    if (frame_itr->m_has_provided_timecode) {
-      frame_itr->m_start = *provided_timecode_itr;
+  for (auto idx : m_presentation_order_indexes) {
+    auto &frame = m_frames[idx];
+
+    if (frame.m_has_provided_timecode) {
+      frame.m_start = *provided_timecode_itr;
       ++provided_timecode_itr;
 
-      if (frames_begin != frame_itr)
-        previous_frame_itr->m_end = frame_itr->m_start;
+      if (previous_frame)
+        previous_frame->m_end = frame.m_start;
 
     } else {
-      frame_itr->m_start = frames_begin == frame_itr ? m_max_timecode : previous_frame_itr->m_end;
+      frame.m_start = !previous_frame ? m_max_timecode : previous_frame->m_end;
       ++m_stats.num_timecodes_generated;
     }
 
-    frame_itr->m_end = frame_itr->m_start + duration_for(frame_itr->m_si);
-
-    previous_frame_itr = frame_itr;
-    ++frame_itr;
+    frame.m_end    = frame.m_start + duration_for(frame.m_si);
+    previous_frame = &frame;
   }
 
-  m_max_timecode = m_frames.back().m_end;
+  m_max_timecode = previous_frame->m_end;
   m_provided_timecodes.erase(m_provided_timecodes.begin(), provided_timecode_itr);
 
   mxdebug_if(m_debug_timecodes, boost::format("CLEANUP frames <pres_ord dec_ord has_prov_tc tc dur>: %1%\n")
-             % boost::accumulate(m_frames, std::string(""), [](std::string const &accu, avc_frame_t const &frame) {
+             % boost::accumulate(m_presentation_order_indexes, std::string(""), [this](std::string const &accu, size_t idx) {
+                 auto const &frame = m_frames[idx];
                  return accu + (boost::format(" <%1% %2% %3% %4% %5%>") % frame.m_presentation_order % frame.m_decode_order % frame.m_has_provided_timecode % frame.m_start % (frame.m_end - frame.m_start)).str();
                }));
 
-
-  if (!m_simple_picture_order)
-    brng::sort(m_frames, [](const avc_frame_t &f1, const avc_frame_t &f2) { return f1.m_decode_order < f2.m_decode_order; });
-
-  frames_begin       = m_frames.begin();
-  frames_end         = m_frames.end();
+  auto frames_begin = m_frames.begin();
+  auto frames_end   = m_frames.end();
 
   // This may be wrong but is needed for mkvmerge to work correctly
   // (cluster_helper etc).
@@ -1685,7 +1658,7 @@ mpeg4::p10::avc_es_parser_c::cleanup() {
 
   // mxinfo(boost::format("frame order calculation\n"));
 
-  for (frame_itr = frames_begin; frames_end != frame_itr; ++frame_itr) {
+  for (auto frame_itr = frames_begin; frames_end != frame_itr; ++frame_itr) {
     // mxinfo(boost::format("  type %4% decode order %1% presentation order %2% timestamp %3%\n") % frame_itr->m_decode_order % frame_itr->m_presentation_order % format_timecode(frame_itr->m_start) % frame_itr->m_type);
 
     if (!frame_itr->is_i_frame() && (frames_begin != frame_itr))
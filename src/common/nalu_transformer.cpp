@@ -0,0 +1,185 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit http://www.gnu.org/copyleft/gpl.html
+
+   NALU transformer for AVC and HEVC frames
+
+   Written by Moritz Bunkus <moritz@bunkus.org>.
+*/
+
+#include "common/common_pch.h"
+
+#include "common/nalu_transformer.h"
+
+namespace {
+
+uint64_t
+read_size(unsigned char const *buffer,
+          unsigned int size_len) {
+  uint64_t value = 0;
+  for (auto idx = 0u; idx < size_len; ++idx)
+    value = (value << 8) | buffer[idx];
+
+  return value;
+}
+
+void
+write_size(unsigned char *buffer,
+           unsigned int size_len,
+           uint64_t value) {
+  for (auto idx = size_len; idx > 0; --idx) {
+    buffer[idx - 1]   = value & 0xff;
+    value           >>= 8;
+  }
+}
+
+}
+
+nalu_transformer_c::nalu_transformer_c(codec_e codec,
+                                       unsigned int src_size_len,
+                                       unsigned int dst_size_len)
+  : m_codec{codec}
+  , m_src_size_len{src_size_len}
+  , m_dst_size_len{dst_size_len}
+  , m_max_nalu_size{8 <= dst_size_len ? std::numeric_limits<uint64_t>::max() : (1ull << (8 * dst_size_len)) - 1}
+  , m_types_to_drop{}
+{
+  assert(src_size_len && dst_size_len);
+}
+
+void
+nalu_transformer_c::drop_type(unsigned int type) {
+  m_types_to_drop |= 1ull << (type & 0x3f);
+}
+
+unsigned int
+nalu_transformer_c::get_nalu_type(unsigned char header_byte)
+  const {
+  return codec_e::hevc == m_codec ? (header_byte >> 1) & 0x3f : header_byte & 0x1f;
+}
+
+bool
+nalu_transformer_c::is_dropped(unsigned char const *nalu,
+                               uint64_t nalu_size)
+  const {
+  return nalu_size && (m_types_to_drop & (1ull << get_nalu_type(nalu[0])));
+}
+
+size_t
+nalu_transformer_c::calculate_output_size(unsigned char const *src,
+                                          size_t src_size)
+  const {
+  // Only the length fields and the NALU header bytes are looked at
+  // here, not the NALU payloads.
+  auto src_pos  = size_t{};
+  auto dst_size = size_t{};
+
+  while ((src_pos + m_src_size_len) <= src_size) {
+    auto nalu_size = std::min<uint64_t>(read_size(&src[src_pos], m_src_size_len), src_size - src_pos - m_src_size_len);
+    auto nalu      = &src[src_pos + m_src_size_len];
+    src_pos       += m_src_size_len + nalu_size;
+
+    if (!is_dropped(nalu, nalu_size))
+      dst_size += m_dst_size_len + nalu_size;
+  }
+
+  return dst_size;
+}
+
+bool
+nalu_transformer_c::copy_nalus(unsigned char const *src,
+                               size_t src_size,
+                               unsigned char *dst,
+                               size_t &dst_size)
+  const {
+  // If src and dst are the same buffer then the write position never
+  // overtakes the read position as the length fields don't grow in
+  // that case.
+  auto src_pos = size_t{};
+  auto dst_pos = size_t{};
+
+  while ((src_pos + m_src_size_len) <= src_size) {
+    auto nalu_size = read_size(&src[src_pos], m_src_size_len);
+    auto available = src_size - src_pos - m_src_size_len;
+
+    if ((nalu_size > available) && (m_src_size_len == m_dst_size_len))
+      break;
+
+    nalu_size  = std::min<uint64_t>(nalu_size, available);
+    auto nalu  = &src[src_pos + m_src_size_len];
+    src_pos   += m_src_size_len + nalu_size;
+
+    if (is_dropped(nalu, nalu_size))
+      continue;
+
+    if (nalu_size > m_max_nalu_size)
+      return false;
+
+    write_size(&dst[dst_pos], m_dst_size_len, nalu_size);
+    dst_pos += m_dst_size_len;
+
+    if (&dst[dst_pos] != nalu)
+      memmove(&dst[dst_pos], nalu, nalu_size);
+    dst_pos += nalu_size;
+  }
+
+  // If the length fields keep their size then broken data at the end
+  // is kept as it is.
+  if ((m_src_size_len == m_dst_size_len) && (src_pos < src_size)) {
+    if (&dst[dst_pos] != &src[src_pos])
+      memmove(&dst[dst_pos], &src[src_pos], src_size - src_pos);
+    dst_pos += src_size - src_pos;
+  }
+
+  dst_size = dst_pos;
+
+  return true;
+}
+
+/** \brief Transform a frame
+
+   The frame's length fields are changed to the destination size, and
+   NALUs whose type has been registered with \c drop_type() are
+   removed. If the size of the length fields is changed then a length
+   field claiming more bytes than the frame contains is truncated to
+   the frame's end, and trailing bytes too short for a length field
+   are dropped. Otherwise such broken data is kept unchanged.
+
+   \param data The frame. It is modified in place or replaced with a
+     newly allocated buffer.
+   \return \c false if a NALU is too big for the destination length
+     field size. The content of \c data is undefined in that case.
+*/
+bool
+nalu_transformer_c::transform(memory_cptr &data)
+  const {
+  auto src      = data->get_buffer();
+  auto src_size = data->get_size();
+  auto dst_size = size_t{};
+
+  if (!src || !src_size)
+    return true;
+
+  if (m_dst_size_len <= m_src_size_len) {
+    if (!copy_nalus(src, src_size, src, dst_size))
+      return false;
+
+    if (dst_size != src_size)
+      data->resize(dst_size);
+
+    return true;
+  }
+
+  auto new_data = memory_c::alloc(std::max<size_t>(calculate_output_size(src, src_size), 1));
+  if (!copy_nalus(src, src_size, new_data->get_buffer(), dst_size))
+    return false;
+
+  new_data->set_size(dst_size);
+  data = new_data;
+
+  return true;
+}
@@ -0,0 +1,52 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit http://www.gnu.org/copyleft/gpl.html
+
+   class definition for the NALU transformer for AVC and HEVC frames
+
+   Written by Moritz Bunkus <moritz@bunkus.org>.
+*/
+
+#ifndef MTX_COMMON_NALU_TRANSFORMER_H
+#define MTX_COMMON_NALU_TRANSFORMER_H
+
+#include "common/common_pch.h"
+
+/* Rewrites frames consisting of length-prefixed NALUs: the size of
+   the length fields can be changed, and NALUs of certain types can be
+   dropped. Both happen in a single pass over the frame. The frame is
+   modified in place unless the length fields grow; in that case a new
+   buffer of the exact output size is allocated once. */
+
+class nalu_transformer_c {
+public:
+  enum class codec_e {
+    avc,
+    hevc,
+  };
+
+protected:
+  codec_e m_codec;
+  unsigned int m_src_size_len, m_dst_size_len;
+  uint64_t m_max_nalu_size, m_types_to_drop;
+
+public:
+  nalu_transformer_c(codec_e codec, unsigned int src_size_len, unsigned int dst_size_len);
+
+  void drop_type(unsigned int type);
+  bool transform(memory_cptr &data) const;
+
+protected:
+  unsigned int get_nalu_type(unsigned char header_byte) const;
+  bool is_dropped(unsigned char const *nalu, uint64_t nalu_size) const;
+  size_t calculate_output_size(unsigned char const *src, size_t src_size) const;
+  bool copy_nalus(unsigned char const *src, size_t src_size, unsigned char *dst, size_t &dst_size) const;
+};
+
+using nalu_transformer_cptr = std::shared_ptr<nalu_transformer_c>;
+
+#endif  // MTX_COMMON_NALU_TRANSFORMER_H
@@ -13,7 +13,9 @@
 
 #include "common/common_pch.h"
 
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 #include "common/ebml.h"
 #include "common/endian.h"
@@ -33,6 +35,10 @@ std::shared_ptr<mm_io_c> g_mm_stdio   = std::shared_ptr<mm_io_c>(new mm_stdio_c)
 
 static mxmsg_handler_t s_mxmsg_info_handler, s_mxmsg_warning_handler, s_mxmsg_error_handler;
 
+static std::mutex s_deferred_warnings_mutex;
+static std::thread::id s_warnings_deferring_thread;
+static std::vector<std::string> s_deferred_warnings;
+
 void
 redirect_stdio(const mm_io_cptr &stdio) {
   g_mm_stdio            = stdio;
@@ -63,6 +69,11 @@ mxmsg(unsigned int level,
       std::string message) {
   static bool s_saw_cr_after_nl = false;
 
+  // mkvmerge closes finished output files in a background thread
+  // whose debug output must not be interleaved with the main thread's.
+  static std::mutex s_mutex;
+  std::lock_guard<std::mutex> lock{s_mutex};
+
   if (g_suppress_info && (MXMSG_INFO == level))
     return;
 
@@ -129,9 +140,43 @@ default_mxwarn(unsigned int,
 
 void
 mxwarn(std::string const &warning) {
+  {
+    std::lock_guard<std::mutex> lock{s_deferred_warnings_mutex};
+
+    if (std::this_thread::get_id() == s_warnings_deferring_thread) {
+      s_deferred_warnings.push_back(warning);
+      return;
+    }
+  }
+
   s_mxmsg_warning_handler(MXMSG_WARNING, warning);
 }
 
+/* The message handlers aren't thread-safe. A background thread can
+   call defer_warnings_of_this_thread() so that its warnings are kept
+   until the thread that has been waiting for it calls
+   output_deferred_warnings(). Only one thread can defer its warnings
+   at a time. */
+void
+defer_warnings_of_this_thread() {
+  std::lock_guard<std::mutex> lock{s_deferred_warnings_mutex};
+  s_warnings_deferring_thread = std::this_thread::get_id();
+}
+
+void
+output_deferred_warnings() {
+  std::vector<std::string> warnings;
+
+  {
+    std::lock_guard<std::mutex> lock{s_deferred_warnings_mutex};
+    s_warnings_deferring_thread = std::thread::id{};
+    warnings.swap(s_deferred_warnings);
+  }
+
+  for (auto const &warning : warnings)
+    mxwarn(warning);
+}
+
 static void
 default_mxerror(unsigned int,
                 std::string const &error) {
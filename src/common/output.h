@@ -62,6 +62,9 @@ mxwarn(const boost::format &warning) {
   mxwarn(warning.str());
 }
 
+void defer_warnings_of_this_thread();
+void output_deferred_warnings();
+
 void mxerror(const std::string &error);
 inline void
 mxerror(const boost::format &error) {
@@ -0,0 +1,137 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit http://www.gnu.org/copyleft/gpl.html
+
+   conversion between NALUs and raw byte sequence payloads (AVC, HEVC)
+
+   Written by Moritz Bunkus <moritz@bunkus.org>.
+*/
+
+#include "common/common_pch.h"
+
+#include "common/rbsp.h"
+
+namespace mtx { namespace rbsp {
+
+namespace {
+
+/* Returns the position of the next emulation prevention byte, a 0x03
+   preceded by two zero bytes, that lies completely within [start,
+   size), or size if there is none. */
+size_t
+find_emulation_prevention_byte(unsigned char const *src,
+                               size_t start,
+                               size_t size) {
+  auto position = start + 2;
+
+  while (position < size) {
+    auto found = static_cast<unsigned char const *>(std::memchr(&src[position], 0x03, size - position));
+    if (!found)
+      break;
+
+    position = found - src;
+    if (!src[position - 1] && !src[position - 2])
+      return position;
+
+    position += 1;
+  }
+
+  return size;
+}
+
+}
+
+/** \brief Remove the emulation prevention bytes from the start of a NALU
+
+   Conversion stops when either the source has been consumed or \c
+   dst_size bytes have been written. This allows converting only the
+   part of a NALU that is actually parsed, e.g. a slice header.
+
+   \return The number of bytes written to \c dst.
+*/
+size_t
+nalu_to_rbsp(unsigned char const *src,
+             size_t src_size,
+             unsigned char *dst,
+             size_t dst_size) {
+  size_t src_pos = 0, dst_pos = 0;
+
+  while ((src_pos < src_size) && (dst_pos < dst_size)) {
+    auto epb_pos  = find_emulation_prevention_byte(src, src_pos, src_size);
+    auto num      = std::min(epb_pos - src_pos, dst_size - dst_pos);
+
+    std::memcpy(&dst[dst_pos], &src[src_pos], num);
+
+    dst_pos += num;
+    src_pos  = epb_pos + 1;
+  }
+
+  return dst_pos;
+}
+
+/** \brief Remove the emulation prevention bytes from a NALU
+
+   \return \c buffer itself if it doesn't contain emulation prevention
+     bytes; otherwise a new buffer with them removed.
+*/
+memory_cptr
+nalu_to_rbsp(memory_cptr const &buffer) {
+  auto src  = buffer->get_buffer();
+  auto size = buffer->get_size();
+
+  if (find_emulation_prevention_byte(src, 0, size) == size)
+    return buffer;
+
+  auto rbsp = memory_c::alloc(size);
+  rbsp->set_size(nalu_to_rbsp(src, size, rbsp->get_buffer(), size));
+
+  return rbsp;
+}
+
+/** \brief Insert emulation prevention bytes into an RBSP
+
+   An emulation prevention byte is inserted in front of each byte not
+   greater than 0x03 that follows two zero bytes.
+
+   \return \c buffer itself if nothing has to be inserted; otherwise a
+     new buffer of the exact size required.
+*/
+memory_cptr
+rbsp_to_nalu(memory_cptr const &buffer) {
+  auto src           = buffer->get_buffer();
+  auto size          = buffer->get_size();
+  auto num_to_insert = 0u;
+  auto num_zeros     = 0u;
+
+  for (auto pos = 0u; pos < size; ++pos) {
+    if ((2 == num_zeros) && (0x03 >= src[pos])) {
+      ++num_to_insert;
+      num_zeros = 0;
+    }
+    num_zeros = src[pos] ? 0 : num_zeros + 1;
+  }
+
+  if (!num_to_insert)
+    return buffer;
+
+  auto nalu = memory_c::alloc(size + num_to_insert);
+  auto dst  = nalu->get_buffer();
+  num_zeros = 0;
+
+  for (auto pos = 0u; pos < size; ++pos) {
+    if ((2 == num_zeros) && (0x03 >= src[pos])) {
+      *dst++    = 0x03;
+      num_zeros = 0;
+    }
+    *dst++    = src[pos];
+    num_zeros = src[pos] ? 0 : num_zeros + 1;
+  }
+
+  return nalu;
+}
+
+}}
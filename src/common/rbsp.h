@@ -0,0 +1,31 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit http://www.gnu.org/copyleft/gpl.html
+
+   conversion between NALUs and raw byte sequence payloads (AVC, HEVC)
+
+   Written by Moritz Bunkus <moritz@bunkus.org>.
+*/
+
+#ifndef MTX_COMMON_RBSP_H
+#define MTX_COMMON_RBSP_H
+
+#include "common/common_pch.h"
+
+namespace mtx { namespace rbsp {
+
+/* Number of bytes converted for parsing slice headers. The parsers
+   only read the first few fields which fit into a fraction of it. */
+size_t const slice_header_prefix_size = 256;
+
+size_t nalu_to_rbsp(unsigned char const *src, size_t src_size, unsigned char *dst, size_t dst_size);
+memory_cptr nalu_to_rbsp(memory_cptr const &buffer);
+memory_cptr rbsp_to_nalu(memory_cptr const &buffer);
+
+}}
+
+#endif  // MTX_COMMON_RBSP_H
@@ -52,6 +52,55 @@ by(Titer first,
   std::transform(to_sort.begin(), to_sort.end(), first, [](pair_type &pair) -> value_type && { return std::move(pair.first); });
 }
 
+// --------------- sort nearly sorted ranges
+
+/* Insertion sort for ranges in which each element is only a few
+   positions away from its final place, e.g. frames in decode order
+   that have to be brought into presentation order. The cost is
+   proportional to the number of elements times their maximum
+   displacement. Equal elements keep their relative order. */
+
+template<  typename Titer
+         , typename Tcomparator = std::less<typename std::iterator_traits<Titer>::value_type>
+         >
+void
+nearly_sorted(Titer first,
+              Titer last,
+              Tcomparator comparator = Tcomparator{}) {
+  if (first == last)
+    return;
+
+  for (auto current = std::next(first); current != last; ++current) {
+    if (!comparator(*current, *std::prev(current)))
+      continue;
+
+    auto value = std::move(*current);
+    auto hole  = current;
+
+    do {
+      *hole = std::move(*std::prev(hole));
+      --hole;
+    } while ((hole != first) && comparator(value, *std::prev(hole)));
+
+    *hole = std::move(value);
+  }
+}
+
+/* Inserts a value into a sorted container. The insertion point is
+   searched for from the back as values usually arrive almost in
+   order. */
+
+template<typename Tcontainer>
+void
+insert_nearly_sorted(Tcontainer &container,
+                     typename Tcontainer::value_type const &value) {
+  auto position = container.end();
+  while ((position != container.begin()) && (value < *std::prev(position)))
+    --position;
+
+  container.insert(position, value);
+}
+
 // --------------- sort naturally
 
 template<typename StrT>
@@ -157,6 +157,43 @@ escape(const std::string &source) {
   return dst;
 }
 
+/** \brief Escape a string for use inside a JSON string literal
+
+   Only the characters JSON requires to be escaped are escaped. The
+   result doesn't include the surrounding quotes.
+*/
+std::string
+escape_json(std::string const &source) {
+  static char const s_hex_digits[] = "0123456789abcdef";
+
+  std::string dst;
+  dst.reserve(source.length());
+
+  for (auto c : source) {
+    auto uc = static_cast<unsigned char>(c);
+
+    if ((c == '"') || (c == '\\')) {
+      dst += '\\';
+      dst += c;
+
+    } else if (c == '\n')
+      dst += "\\n";
+    else if (c == '\r')
+      dst += "\\r";
+    else if (c == '\t')
+      dst += "\\t";
+    else if (uc < 0x20) {
+      dst += "\\u00";
+      dst += s_hex_digits[uc >> 4];
+      dst += s_hex_digits[uc & 0x0f];
+
+    } else
+      dst += c;
+  }
+
+  return dst;
+}
+
 std::string
 unescape(const std::string &source) {
   std::string dst;
@@ -0,0 +1,331 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit http://www.gnu.org/copyleft/gpl.html
+
+   helper functions for parsing SRT and SSA/ASS subtitles
+
+   Written by Moritz Bunkus <moritz@bunkus.org>.
+*/
+
+#include "common/common_pch.h"
+
+#include "common/text_subtitles.h"
+
+namespace mtx { namespace text_subtitles {
+
+namespace {
+
+// The same characters "\s" matches.
+inline bool
+is_space(char c) {
+  return (' ' == c) || ('\t' == c) || ('\n' == c) || ('\r' == c) || ('\v' == c) || ('\f' == c);
+}
+
+inline bool
+is_digit(char c) {
+  return ('0' <= c) && ('9' >= c);
+}
+
+inline char const *
+skip_spaces(char const *p,
+            char const *end) {
+  while ((p < end) && is_space(*p))
+    ++p;
+  return p;
+}
+
+inline char const *
+skip_digits(char const *p,
+            char const *end) {
+  while ((p < end) && is_digit(*p))
+    ++p;
+  return p;
+}
+
+struct srt_value_t {
+  bool negative;
+  char const *digits, *digits_end;
+};
+
+// Equivalent of "\s*(-?)\s*(\d+)".
+bool
+parse_srt_value(char const *&p,
+                char const *end,
+                srt_value_t &value) {
+  p              = skip_spaces(p, end);
+  value.negative = (p < end) && ('-' == *p);
+  if (value.negative)
+    p = skip_spaces(p + 1, end);
+
+  value.digits     = p;
+  value.digits_end = skip_digits(p, end);
+  p                = value.digits_end;
+
+  return value.digits != value.digits_end;
+}
+
+// Values that don't fit into an int are treated as 0 just like a
+// failing parse_number() did.
+int
+srt_value_to_int(srt_value_t const &value) {
+  int64_t result = 0;
+
+  for (auto p = value.digits; p < value.digits_end; ++p) {
+    result = result * 10 + (*p - '0');
+    if (result > std::numeric_limits<int>::max())
+      return 0;
+  }
+
+  return result;
+}
+
+// Equivalent of "H:M:S[,.:]F" with each of the four parts being an
+// optionally negative number. The fraction is scaled to nanoseconds
+// by only considering its first nine digits.
+bool
+parse_srt_timecode(char const *&p,
+                   char const *end,
+                   int64_t &timecode) {
+  srt_value_t values[4];
+
+  for (auto idx = 0; idx < 4; ++idx) {
+    if (!parse_srt_value(p, end, values[idx]))
+      return false;
+
+    if (3 == idx)
+      break;
+
+    auto separator_ok = (p < end) && ((':' == *p) || ((2 == idx) && ((',' == *p) || ('.' == *p))));
+    if (!separator_ok)
+      return false;
+
+    ++p;
+  }
+
+  int64_t negative = 1;
+  for (auto const &value : values)
+    if (value.negative)
+      negative *= -1;
+
+  timecode  = static_cast<int64_t>(srt_value_to_int(values[0])) * 60 * 60 + srt_value_to_int(values[1]) * 60 + srt_value_to_int(values[2]);
+  timecode *= 1000000000ll * negative;
+
+  int64_t fraction = 0;
+  auto digit       = values[3].digits;
+  for (auto idx = 0; idx < 9; ++idx)
+    fraction = fraction * 10 + (digit < values[3].digits_end ? *digit++ - '0' : 0);
+
+  timecode += fraction;
+
+  return true;
+}
+
+}
+
+/** \brief Whether or not a line consists of digits only ("^\d+$")
+ */
+bool
+is_srt_number(std::string const &line) {
+  if (line.empty())
+    return false;
+
+  for (auto c : line)
+    if (!is_digit(c))
+      return false;
+
+  return true;
+}
+
+/** \brief Parse an SRT timecode line
+
+   Accepts the same lines as the regular expression
+   "^T\s*[\-\s]+>\s*T" did with \c T being the expression for a
+   single timecode described in \c parse_srt_timecode. Anything after
+   the second timecode, e.g. coordinates, is ignored.
+
+   \return \c true if the line was parsed successfully. \c start and
+     \c end are set to the timecodes in nanoseconds in that case.
+*/
+bool
+parse_srt_timecode_line(std::string const &line,
+                        int64_t &start,
+                        int64_t &end) {
+  auto p        = line.c_str();
+  auto line_end = p + line.length();
+
+  if (!parse_srt_timecode(p, line_end, start))
+    return false;
+
+  auto arrow = p;
+  while ((p < line_end) && (('-' == *p) || is_space(*p)))
+    ++p;
+
+  if ((p == arrow) || (p == line_end) || ('>' != *p))
+    return false;
+
+  ++p;
+
+  return parse_srt_timecode(p, line_end, end);
+}
+
+/** \brief Whether or not a timecode line ends with coordinates
+
+   Equivalent of searching for "([XY]\d+:\d+\s*){4}\s*$".
+*/
+bool
+has_srt_coordinates(std::string const &line) {
+  auto line_begin = line.c_str();
+  auto line_end   = line_begin + line.length();
+
+  for (auto start = line_begin; start < line_end; ++start) {
+    if (('X' != *start) && ('Y' != *start))
+      continue;
+
+    auto p   = start;
+    auto idx = 0;
+
+    for (; idx < 4; ++idx) {
+      if ((p == line_end) || (('X' != *p) && ('Y' != *p)))
+        break;
+
+      auto digits = p + 1;
+      p           = skip_digits(digits, line_end);
+      if ((p == digits) || (p == line_end) || (':' != *p))
+        break;
+
+      digits = p + 1;
+      p      = skip_digits(digits, line_end);
+      if (p == digits)
+        break;
+
+      p = skip_spaces(p, line_end);
+    }
+
+    if ((4 == idx) && (p == line_end))
+      return true;
+  }
+
+  return false;
+}
+
+/** \brief Whether or not a line starts an SSA/ASS section
+
+   \c name must be in lower case. A space in it matches one or more
+   white space characters in \c line. Leading white space is ignored
+   as are characters following the closing bracket, e.g. "v4+ styles"
+   is the equivalent of searching for "^\s*\[V4\+\s+Styles\]" without
+   regard to case.
+*/
+bool
+is_ssa_section(std::string const &line,
+               char const *name) {
+  auto p   = line.c_str();
+  auto end = p + line.length();
+
+  p = skip_spaces(p, end);
+  if ((p == end) || ('[' != *p))
+    return false;
+
+  ++p;
+
+  for (; *name; ++name) {
+    if (' ' == *name) {
+      if ((p == end) || !is_space(*p))
+        return false;
+      p = skip_spaces(p, end);
+
+    } else if ((p == end) || (std::tolower(static_cast<unsigned char>(*p)) != *name))
+      return false;
+
+    else
+      ++p;
+  }
+
+  return (p < end) && (']' == *p);
+}
+
+/** \brief Whether or not a line is empty or an SSA/ASS comment
+
+   Equivalent of searching for "^\s*$|^\s*[!;]".
+*/
+bool
+is_ssa_comment_or_empty(std::string const &line) {
+  auto p   = line.c_str();
+  auto end = p + line.length();
+
+  p = skip_spaces(p, end);
+
+  return (p == end) || ('!' == *p) || (';' == *p);
+}
+
+/** \brief Split the fields of an SSA/ASS event line
+
+   The part of \c line starting at \c offset is split at commas into
+   at most \c max_fields fields. The last field contains the rest of
+   the line including further commas. Missing fields are set to empty
+   strings so that \c fields always contains \c max_fields entries.
+   Existing strings in \c fields are re-used.
+*/
+void
+split_ssa_fields(std::string const &line,
+                 size_t offset,
+                 size_t max_fields,
+                 std::vector<std::string> &fields) {
+  fields.resize(max_fields);
+
+  auto position = std::min(offset, line.length());
+  auto idx      = 0u;
+
+  for (; (idx + 1) < max_fields; ++idx) {
+    auto comma = line.find(',', position);
+    if (std::string::npos == comma)
+      break;
+
+    fields[idx].assign(line, position, comma - position);
+    position = comma + 1;
+  }
+
+  if (idx < max_fields)
+    fields[idx++].assign(line, position, std::string::npos);
+
+  for (; idx < max_fields; ++idx)
+    fields[idx].clear();
+}
+
+/** \brief Normalize the line endings of a subtitle entry
+
+   Carriage returns are removed, trailing line feeds are dropped and
+   the remaining line feeds are replaced by CR LF, all in a single
+   pass over \c src. The result is stored in \c dst.
+*/
+void
+normalize_line_endings(char const *src,
+                       size_t size,
+                       std::string &dst) {
+  dst.clear();
+  dst.reserve(size + size / 8);
+
+  auto pending_newlines = 0u;
+  auto end              = src + size;
+
+  for (; src < end; ++src) {
+    if ('\r' == *src)
+      continue;
+
+    if ('\n' == *src) {
+      ++pending_newlines;
+      continue;
+    }
+
+    for (; pending_newlines > 0; --pending_newlines)
+      dst.append("\r\n", 2);
+
+    dst += *src;
+  }
+}
+
+}}
@@ -0,0 +1,38 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit http://www.gnu.org/copyleft/gpl.html
+
+   helper functions for parsing SRT and SSA/ASS subtitles
+
+   Written by Moritz Bunkus <moritz@bunkus.org>.
+*/
+
+#ifndef MTX_COMMON_TEXT_SUBTITLES_H
+#define MTX_COMMON_TEXT_SUBTITLES_H
+
+#include "common/common_pch.h"
+
+/* Hand-written replacements for the regular expressions the SRT and
+   SSA/ASS readers and the text subtitle packetizer used for each line
+   and each entry. They accept exactly what the expressions matched,
+   but don't allocate and look at each character once. */
+
+namespace mtx { namespace text_subtitles {
+
+bool is_srt_number(std::string const &line);
+bool parse_srt_timecode_line(std::string const &line, int64_t &start, int64_t &end);
+bool has_srt_coordinates(std::string const &line);
+
+bool is_ssa_section(std::string const &line, char const *name);
+bool is_ssa_comment_or_empty(std::string const &line);
+void split_ssa_fields(std::string const &line, size_t offset, size_t max_fields, std::vector<std::string> &fields);
+
+void normalize_line_endings(char const *src, size_t size, std::string &dst);
+
+}}
+
+#endif  // MTX_COMMON_TEXT_SUBTITLES_H
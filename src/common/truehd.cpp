@@ -49,13 +49,16 @@ truehd_parser_c::add_data(const unsigned char *new_data,
   if (!new_data || (0 == new_size))
     return;
 
-  m_buffer.add(new_data, new_size);
-
-  parse(false);
+  add_bytes(new_data, new_size);
 }
 
 void
 truehd_parser_c::parse(bool end_of_stream) {
+  parse_buffer(end_of_stream);
+}
+
+void
+truehd_parser_c::parse_buffer(bool end_of_stream) {
   unsigned char *data = m_buffer.get_buffer();
   unsigned int size   = m_buffer.get_size();
   unsigned int offset = 0;
@@ -124,7 +127,7 @@ truehd_parser_c::parse(bool end_of_stream) {
     if ((frame->m_size + offset) > size)
       break;
 
-    frame->m_data = memory_c::clone(&data[offset], frame->m_size);
+    frame->m_data = m_buffer.get_frame_data(offset, frame->m_size);
 
     mxverb(3,
            boost::format("codec %7% type %1% offset %2% size %3% channels %4% sampling_rate %5% samples_per_frame %6%\n")
@@ -167,12 +170,24 @@ truehd_parser_c::resync(unsigned int offset) {
 
   m_sync_state              = state_unsynced;
 
-  for (offset = offset + 4; (offset + 4) < size; ++offset) {
-    uint32_t sync_word = get_uint32_be(&data[offset]);
-    if ((TRUEHD_SYNC_WORD == sync_word) || (MLP_SYNC_WORD == sync_word) || (AC3_SYNC_WORD == get_uint16_be(&data[offset - 4]))) {
-      m_sync_state  = state_synced;
-      return offset - 4;
+  // TrueHD and MLP sync words are located four bytes into the frame,
+  // AC-3 sync words at its start. Only the positions of candidates
+  // for either are checked.
+  while ((offset + 8) < size) {
+    auto truehd_start = offset + mtx::frame_sync::find_sync_word(&data[offset + 4], size - offset - 4, TRUEHD_SYNC_WORD >> 24, (TRUEHD_SYNC_WORD >> 16) & 0xff);
+    auto ac3_start    = offset + mtx::frame_sync::find_sync_word(&data[offset],     size - offset,     AC3_SYNC_WORD >> 8,     AC3_SYNC_WORD & 0xff);
+    offset            = std::min(truehd_start, ac3_start);
+
+    if ((offset + 8) >= size)
+      break;
+
+    uint32_t sync_word = get_uint32_be(&data[offset + 4]);
+    if ((TRUEHD_SYNC_WORD == sync_word) || (MLP_SYNC_WORD == sync_word) || (AC3_SYNC_WORD == get_uint16_be(&data[offset]))) {
+      m_sync_state = state_synced;
+      return offset;
     }
+
+    ++offset;
   }
 
   return 0;
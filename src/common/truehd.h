@@ -19,7 +19,7 @@
 #include <deque>
 
 #include "common/ac3.h"
-#include "common/byte_buffer.h"
+#include "common/frame_sync_parser.h"
 
 #define TRUEHD_SYNC_WORD 0xf8726fba
 #define MLP_SYNC_WORD    0xf8726fbb
@@ -73,16 +73,13 @@ struct truehd_frame_t {
 };
 using truehd_frame_cptr = std::shared_ptr<truehd_frame_t>;
 
-class truehd_parser_c {
+class truehd_parser_c: public frame_sync_parser_c<truehd_frame_cptr> {
 protected:
   enum {
     state_unsynced,
     state_synced,
   } m_sync_state;
 
-  byte_buffer_c m_buffer;
-  std::deque<truehd_frame_cptr> m_frames;
-
 public:
   truehd_parser_c();
   virtual ~truehd_parser_c();
@@ -93,6 +90,7 @@ public:
   virtual truehd_frame_cptr get_next_frame();
 
 protected:
+  virtual void parse_buffer(bool end_of_stream);
   virtual unsigned int resync(unsigned int offset);
   virtual int decode_channel_map(int channel_map);
 };
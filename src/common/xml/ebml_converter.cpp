@@ -342,7 +342,10 @@ ebml_converter_c::to_ebml(std::string const &file_name,
 
   ebml_master_cptr ebml_root{new KaxSegment};
 
-  to_ebml_recursively(*ebml_root, root_node);
+  // The root's children are removed from the document as soon as
+  // they've been converted. That way the whole document and the whole
+  // EBML tree don't have to be kept in memory at the same time.
+  to_ebml_recursively(*ebml_root, root_node, true);
 
   auto master = dynamic_cast<EbmlMaster *>((*ebml_root)[0]);
   if (!master)
@@ -360,7 +363,8 @@ ebml_converter_c::to_ebml(std::string const &file_name,
 
 void
 ebml_converter_c::to_ebml_recursively(EbmlMaster &parent,
-                                      pugi::xml_node &node)
+                                      pugi::xml_node &node,
+                                      bool release_children)
   const {
   // Skip <EBMLVoid> elements.
   if (std::string(node.name()) == "EBMLVoid")
@@ -381,14 +385,21 @@ ebml_converter_c::to_ebml_recursively(EbmlMaster &parent,
     convert_node_or_attribute_to_ebml(*converted_master, node, *attribute, handled_attributes);
   }
 
-  for (auto child : node) {
-    if (child.type() != pugi::node_element)
-      continue;
+  auto child = node.first_child();
+  while (child) {
+    auto next_child = child.next_sibling();
+
+    if (child.type() == pugi::node_element) {
+      if (!converted_master)
+        throw invalid_child_node_x{ node.first_child().name(), node.name(), node.offset_debug() };
 
-    if (converted_master)
       to_ebml_recursively(*converted_master, child);
-    else
-      throw invalid_child_node_x{ node.first_child().name(), node.name(), node.offset_debug() };
+    }
+
+    if (release_children)
+      node.remove_child(child);
+
+    child = next_child;
   }
 }
 
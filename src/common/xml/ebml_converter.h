@@ -80,7 +80,7 @@ protected:
 
   void to_xml_recursively(pugi::xml_node &parent, EbmlElement &e) const;
 
-  void to_ebml_recursively(EbmlMaster &parent, pugi::xml_node &node) const;
+  void to_ebml_recursively(EbmlMaster &parent, pugi::xml_node &node, bool release_children = false) const;
   EbmlElement *convert_node_or_attribute_to_ebml(EbmlMaster &parent, pugi::xml_node const &node, pugi::xml_attribute const &attribute, std::map<std::string, bool> &handled_attributes) const;
   EbmlElement *verify_and_create_element(EbmlMaster &parent, std::string const &name, pugi::xml_node const &node) const;
 
@@ -13,6 +13,8 @@
 
 #include "common/common_pch.h"
 
+#include <future>
+#include <mutex>
 #include <sstream>
 
 #include "common/mm_io_x.h"
@@ -55,37 +57,118 @@ create_node_name(const char *name,
   return node_name;
 }
 
-document_cptr
-load_file(std::string const &file_name,
-          unsigned int options,
+namespace {
+
+struct file_content_t {
+  memory_cptr content;
+  bool has_byte_order_marker;
+};
+
+std::map<std::string, std::future<file_content_t>> s_preloaded_files;
+std::mutex s_preloaded_files_mutex;
+
+// Only reads the raw content. This is safe to do in a background
+// thread; errors are transported as exceptions.
+file_content_t
+read_file(mm_io_cptr const &af_in,
           boost::optional<int64_t> max_read_size) {
-  auto af_in = mm_file_io_c::open(file_name, MODE_READ);
   mm_text_io_c in(af_in.get(), false);
-  std::string content;
   auto bytes_to_read = (max_read_size ? std::min(in.get_size(), *max_read_size) : in.get_size()) - in.get_byte_order_length();
+  auto content       = memory_c::alloc(bytes_to_read);
 
-  if (in.read(content, bytes_to_read) != bytes_to_read)
+  if (in.read(content->get_buffer(), bytes_to_read) != bytes_to_read)
     throw mtx::mm_io::end_of_file_x{};
 
-  if (BO_NONE == in.get_byte_order()) {
+  return { content, BO_NONE != in.get_byte_order() };
+}
+
+document_cptr
+parse_file_content(file_content_t const &file,
+                   unsigned int options) {
+  auto content = file.content;
+
+  if (!file.has_byte_order_marker) {
     boost::regex encoding_re("^ \\s* "              // ignore leading whitespace
                              "<\\?xml"              // XML declaration start
                              "[^\\?]+"              // skip to encoding, but don't go beyond XML declaration
                              "encoding \\s* = \\s*" // encoding attribute
                              "\" ( [^\"]+ ) \"",    // attribute value
                              boost::regex::perl | boost::regex::mod_x | boost::regex::icase);
-    boost::match_results<std::string::const_iterator> matches;
-    if (boost::regex_search(content, matches, encoding_re))
-      content = charset_converter_c::init(matches[1].str())->utf8(content);
+
+    // The XML declaration must be at the start of the file. There's
+    // no need to look at the whole file for it.
+    auto start = reinterpret_cast<char const *>(content->get_buffer());
+    auto end   = start + std::min<int64_t>(content->get_size(), 1024);
+    boost::cmatch matches;
+
+    if (boost::regex_search(start, end, matches, encoding_re))
+      content = memory_c::clone(charset_converter_c::init(matches[1].str())->utf8(std::string(start, content->get_size())));
   }
 
-  std::stringstream scontent(content);
-  auto doc = std::make_shared<pugi::xml_document>();
-  auto result = doc->load(scontent, options);
+  // The document is parsed in place instead of copying the content
+  // into pugixml's own buffer. Therefore the content must live as
+  // long as the document.
+  auto doc    = document_cptr{new pugi::xml_document, [content](pugi::xml_document *document) { delete document; }};
+  auto result = doc->load_buffer_inplace(content->get_buffer(), content->get_size(), options);
   if (!result)
     throw xml_parser_x{result};
 
   return doc;
 }
 
+}
+
+/** \brief Starts reading an XML file in the background
+
+   Only the file's content is read in the background. A later call to
+   \c load_file() for the same file name picks it up, converts and
+   parses it and reports errors, including those from reading.
+
+   The file is opened right away as converting its name to the local
+   charset must not happen outside the main thread. If that fails
+   nothing is preloaded, and \c load_file() reports the error.
+*/
+void
+preload_file(std::string const &file_name) {
+  std::lock_guard<std::mutex> lock{s_preloaded_files_mutex};
+
+  if (s_preloaded_files.find(file_name) != s_preloaded_files.end())
+    return;
+
+  auto af_in = mm_io_cptr{};
+
+  try {
+    af_in = mm_file_io_c::open(file_name, MODE_READ);
+  } catch (mtx::mm_io::exception &) {
+    return;
+  }
+
+  s_preloaded_files[file_name] = std::async(std::launch::async, [af_in]() {
+    return read_file(af_in, boost::optional<int64_t>{});
+  });
+}
+
+document_cptr
+load_file(std::string const &file_name,
+          unsigned int options,
+          boost::optional<int64_t> max_read_size) {
+  if (!max_read_size) {
+    auto preloaded = std::future<file_content_t>{};
+
+    {
+      std::lock_guard<std::mutex> lock{s_preloaded_files_mutex};
+      auto itr = s_preloaded_files.find(file_name);
+      if (itr != s_preloaded_files.end()) {
+        preloaded = std::move(itr->second);
+        s_preloaded_files.erase(itr);
+      }
+    }
+
+    if (preloaded.valid())
+      return parse_file_content(preloaded.get(), options);
+  }
+
+  return parse_file_content(read_file(mm_file_io_c::open(file_name, MODE_READ), max_read_size), options);
+}
+
 }}
@@ -43,14 +43,26 @@ xtr_avc_c::write_nal(const binary *data,
     return false;
   }
 
-  m_out->write(ms_start_code, 4);
-  m_out->write(data + pos, nal_size);
+  m_pending_nals.push_back({ ms_start_code, 4 });
+  m_pending_nals.push_back({ data + pos,     nal_size });
 
   pos += nal_size;
 
   return true;
 }
 
+/* write_nal() only collects the start codes and NALUs. They're
+   written here with a single gather write once the whole frame or
+   codec private has been processed. */
+void
+xtr_avc_c::flush_nals() {
+  if (m_pending_nals.empty())
+    return;
+
+  m_out->writev(m_pending_nals);
+  m_pending_nals.clear();
+}
+
 void
 xtr_avc_c::create_file(xtr_base_c *master,
                        KaxTrackEntry &track) {
@@ -75,13 +87,14 @@ xtr_avc_c::create_file(xtr_base_c *master,
     if (!write_nal(buf, pos, mpriv->get_size(), 2))
       break;
 
-  if (mpriv->get_size() <= pos)
-    return;
+  if (mpriv->get_size() > pos) {
+    unsigned int numpps = buf[pos++];
 
-  unsigned int numpps = buf[pos++];
+    for (i = 0; (i < numpps) && (mpriv->get_size() > pos); ++i)
+      write_nal(buf, pos, mpriv->get_size(), 2);
+  }
 
-  for (i = 0; (i < numpps) && (mpriv->get_size() > pos); ++i)
-    write_nal(buf, pos, mpriv->get_size(), 2);
+  flush_nals();
 }
 
 void
@@ -91,5 +104,7 @@ xtr_avc_c::handle_frame(xtr_frame_t &f) {
 
   while (f.frame->get_size() > pos)
     if (!write_nal(buf, pos, f.frame->get_size(), m_nal_size_size))
-      return;
+      break;
+
+  flush_nals();
 }
@@ -20,6 +20,7 @@
 class xtr_avc_c: public xtr_base_c {
 protected:
   int m_nal_size_size;
+  mm_io_vecs_t m_pending_nals;
 
   static binary const ms_start_code[4];
 
@@ -29,6 +30,7 @@ public:
   virtual void create_file(xtr_base_c *master, KaxTrackEntry &track);
   virtual void handle_frame(xtr_frame_t &f);
   virtual bool write_nal(const binary *data, size_t &pos, size_t data_size, size_t nal_size_size);
+  virtual void flush_nals();
 
   virtual const char *get_container_name() {
     return "AVC/h.264 elementary stream";
@@ -82,7 +82,15 @@ xtr_base_c::create_file(xtr_base_c *master,
 
 void
 xtr_base_c::decode_and_handle_frame(xtr_frame_t &f) {
-  m_content_decoder.reverse(f.frame, CONTENT_ENCODING_SCOPE_BLOCK);
+  if (m_removed_header) {
+    // Write the removed header and the stored frame one after the other
+    // instead of reassembling the whole frame in memory first.
+    m_out->write(m_removed_header);
+    m_bytes_written += m_removed_header->get_size();
+
+  } else
+    m_content_decoder.reverse(f.frame, CONTENT_ENCODING_SCOPE_BLOCK);
+
   handle_frame(f);
 }
 
@@ -121,6 +129,18 @@ xtr_base_c::init_content_decoder(KaxTrackEntry &track) {
     mxerror(Y("Tracks with unsupported content encoding schemes (compression or encryption) cannot be extracted.\n"));
 
   m_content_decoder_initialized = true;
+
+  if (writes_frames_verbatim()) {
+    m_removed_header = m_content_decoder.get_removed_header(CONTENT_ENCODING_SCOPE_BLOCK);
+    if (m_removed_header && !m_removed_header->get_size())
+      m_removed_header.reset();
+  }
+}
+
+bool
+xtr_base_c::writes_frames_verbatim()
+  const {
+  return false;
 }
 
 xtr_base_c *
@@ -129,19 +149,19 @@ xtr_base_c::create_extractor(const std::string &new_codec_id,
                              track_spec_t &tspec) {
   // Raw format
   if (track_spec_t::tm_raw == tspec.target_mode)
-    return new xtr_base_c(new_codec_id, new_tid, tspec);
+    return new xtr_verbatim_c(new_codec_id, new_tid, tspec);
   else if (track_spec_t::tm_full_raw == tspec.target_mode)
     return new xtr_fullraw_c(new_codec_id, new_tid, tspec);
 
   // Audio formats
   else if (new_codec_id == MKV_A_AC3)
-    return new xtr_base_c(new_codec_id, new_tid, tspec, "Dolby Digital (AC3)");
+    return new xtr_verbatim_c(new_codec_id, new_tid, tspec, "Dolby Digital (AC3)");
   else if (new_codec_id == MKV_A_EAC3)
-    return new xtr_base_c(new_codec_id, new_tid, tspec, "Dolby Digital Plus (EAC3)");
+    return new xtr_verbatim_c(new_codec_id, new_tid, tspec, "Dolby Digital Plus (EAC3)");
   else if (balg::istarts_with(new_codec_id, "A_MPEG/L"))
-    return new xtr_base_c(new_codec_id, new_tid, tspec, "MPEG-1 Audio Layer 2/3");
+    return new xtr_verbatim_c(new_codec_id, new_tid, tspec, "MPEG-1 Audio Layer 2/3");
   else if (new_codec_id == MKV_A_DTS)
-    return new xtr_base_c(new_codec_id, new_tid, tspec, "Digital Theater System (DTS)");
+    return new xtr_verbatim_c(new_codec_id, new_tid, tspec, "Digital Theater System (DTS)");
   else if (new_codec_id == MKV_A_PCM)
     return new xtr_wav_c(new_codec_id, new_tid, tspec);
   else if (new_codec_id == MKV_A_FLAC)
@@ -157,9 +177,9 @@ xtr_base_c::create_extractor(const std::string &new_codec_id,
   else if (balg::istarts_with(new_codec_id, "A_REAL/"))
     return new xtr_rmff_c(new_codec_id, new_tid, tspec);
   else if (new_codec_id == MKV_A_MLP)
-    return new xtr_base_c(new_codec_id, new_tid, tspec, "MLP");
+    return new xtr_verbatim_c(new_codec_id, new_tid, tspec, "MLP");
   else if (new_codec_id == MKV_A_TRUEHD)
-    return new xtr_base_c(new_codec_id, new_tid, tspec, "TrueHD");
+    return new xtr_verbatim_c(new_codec_id, new_tid, tspec, "TrueHD");
   else if (new_codec_id == MKV_A_TTA)
     return new xtr_tta_c(new_codec_id, new_tid, tspec);
   else if (new_codec_id == MKV_A_WAVPACK4)
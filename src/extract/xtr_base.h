@@ -44,6 +44,7 @@ public:
 
   content_decoder_c m_content_decoder;
   bool m_content_decoder_initialized;
+  memory_cptr m_removed_header;
 
   bool m_debug;
 
@@ -71,16 +72,31 @@ public:
 
   virtual void init_content_decoder(KaxTrackEntry &track);
   virtual memory_cptr decode_codec_private(KaxCodecPrivate *priv);
+  virtual bool writes_frames_verbatim() const;
 
   static xtr_base_c *create_extractor(const std::string &new_codec_id, int64_t new_tid, track_spec_t &tspec);
 };
 
+// Writes each frame to the output file as it is without looking at its
+// content, e.g. for raw extraction or AC3 and DTS tracks.
+class xtr_verbatim_c : public xtr_base_c {
+public:
+  xtr_verbatim_c(const std::string &codec_id, int64_t tid, track_spec_t &tspec, const char *container_name = nullptr):
+    xtr_base_c(codec_id, tid, tspec, container_name) {}
+  virtual bool writes_frames_verbatim() const {
+    return true;
+  }
+};
+
 class xtr_fullraw_c : public xtr_base_c {
 public:
   xtr_fullraw_c(const std::string &codec_id, int64_t tid, track_spec_t &tspec):
     xtr_base_c(codec_id, tid, tspec) {}
   virtual void create_file(xtr_base_c *master, KaxTrackEntry &track);
   virtual void handle_codec_state(memory_cptr &codec_state);
+  virtual bool writes_frames_verbatim() const {
+    return true;
+  }
 };
 
 #endif
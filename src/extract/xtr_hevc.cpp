@@ -41,13 +41,17 @@ xtr_hevc_c::create_file(xtr_base_c *master,
     pos                 += 3;
 
     while (nal_unit_count && (mpriv->get_size() > pos)) {
-      if (!write_nal(buf, pos, mpriv->get_size(), 2))
+      if (!write_nal(buf, pos, mpriv->get_size(), 2)) {
+        flush_nals();
         return;
+      }
 
       --nal_unit_count;
       --num_parameter_sets;
     }
   }
+
+  flush_nals();
 }
 
 bool
@@ -70,8 +74,8 @@ xtr_hevc_c::write_nal(binary const *data,
   auto start_code_size = m_first_nalu || (HEVC_NALU_TYPE_VIDEO_PARAM == nal_unit_type) || (HEVC_NALU_TYPE_SEQ_PARAM == nal_unit_type) || (HEVC_NALU_TYPE_PIC_PARAM == nal_unit_type) ? 4 : 3;
   m_first_nalu         = false;
 
-  m_out->write(ms_start_code + (4 - start_code_size), start_code_size);
-  m_out->write(data + pos, nal_size);
+  m_pending_nals.push_back({ ms_start_code + (4 - start_code_size), static_cast<size_t>(start_code_size) });
+  m_pending_nals.push_back({ data + pos,                             static_cast<size_t>(nal_size) });
 
   pos += nal_size;
 
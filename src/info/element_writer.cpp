@@ -0,0 +1,357 @@
+/*
+   mkvinfo -- info tracks from Matroska files into other files
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit http://www.gnu.org/copyleft/gpl.html
+
+   machine-readable output formats
+
+   Written by Moritz Bunkus <moritz@bunkus.org>.
+*/
+
+#include "common/common_pch.h"
+
+#include <cmath>
+
+#include <ebml/EbmlBinary.h>
+#include <ebml/EbmlDate.h>
+#include <ebml/EbmlFloat.h>
+#include <ebml/EbmlMaster.h>
+#include <ebml/EbmlSInteger.h>
+#include <ebml/EbmlString.h>
+#include <ebml/EbmlUInteger.h>
+#include <ebml/EbmlUnicodeString.h>
+#include <matroska/KaxBlock.h>
+#include <matroska/KaxBlockData.h>
+#include <matroska/KaxClusterData.h>
+#include <matroska/KaxInfoData.h>
+
+#include "common/ebml.h"
+#include "common/strings/editing.h"
+#include "info/element_writer.h"
+
+namespace {
+
+char const s_hex_digits[] = "0123456789abcdef";
+
+// Binary elements larger than this are written without their contents.
+size_t const s_max_binary_value_size = 16;
+
+void
+append_hex(std::string &dst,
+           unsigned char const *buffer,
+           size_t size) {
+  for (auto idx = 0u; idx < size; ++idx) {
+    dst += s_hex_digits[buffer[idx] >> 4];
+    dst += s_hex_digits[buffer[idx] & 0x0f];
+  }
+}
+
+std::string
+format_id(uint32_t id) {
+  std::string result{"0x"};
+  auto shift = 24;
+
+  while ((shift > 0) && !((id >> shift) & 0xff))
+    shift -= 8;
+
+  for (; shift >= 0; shift -= 8) {
+    unsigned char byte = (id >> shift) & 0xff;
+    append_hex(result, &byte, 1);
+  }
+
+  return result;
+}
+
+std::string
+format_float(double value) {
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.15g", value);
+  return buffer;
+}
+
+}
+
+element_writer_c::record_t::record_t()
+  : m_level{}
+  , m_id{}
+  , m_name{}
+  , m_position{}
+  , m_size{-1}
+  , m_value_type{value_type_e::none}
+  , m_is_block{}
+  , m_track{}
+  , m_timecode{}
+  , m_keyframe{}
+  , m_discardable{}
+{
+}
+
+element_writer_c::element_writer_c(mm_io_cptr const &out)
+  : m_out{out}
+  , m_timecode_scale{TIMECODE_SCALE}
+{
+}
+
+element_writer_c::~element_writer_c() {
+  flush();
+}
+
+element_writer_cptr
+element_writer_c::create(format_e format,
+                         mm_io_cptr const &out) {
+  if (format_e::json == format)
+    return element_writer_cptr{new element_writer_json_c{out}};
+  if (format_e::csv == format)
+    return element_writer_cptr{new element_writer_csv_c{out}};
+  return element_writer_cptr{};
+}
+
+element_writer_c::format_e
+element_writer_c::parse_format(std::string const &format) {
+  if (format == "json")
+    return format_e::json;
+  if (format == "csv")
+    return format_e::csv;
+  throw false;
+}
+
+void
+element_writer_c::write_header() {
+}
+
+void
+element_writer_c::write(std::string const &text) {
+  m_out->write(text.c_str(), text.length());
+}
+
+void
+element_writer_c::flush() {
+  m_out->flush();
+}
+
+void
+element_writer_c::write_tree(EbmlElement &element,
+                             unsigned int level,
+                             KaxCluster *cluster,
+                             EbmlMaster *parent) {
+  if (Is<KaxTimecodeScale>(element))
+    m_timecode_scale = static_cast<KaxTimecodeScale &>(element).GetValue();
+
+  else if (Is<KaxCluster>(element)) {
+    cluster = static_cast<KaxCluster *>(&element);
+    cluster->InitTimecode(FindChildValue<KaxClusterTimecode>(cluster), m_timecode_scale);
+  }
+
+  fill_record(element, level, cluster, parent);
+  write_record(m_record);
+
+  auto master = dynamic_cast<EbmlMaster *>(&element);
+  if (master)
+    for (auto child : *master)
+      write_tree(*child, level + 1, cluster, master);
+}
+
+void
+element_writer_c::fill_record(EbmlElement &element,
+                              unsigned int level,
+                              KaxCluster *cluster,
+                              EbmlMaster *parent) {
+  auto &r         = m_record;
+  r.m_level       = level;
+  r.m_id          = EBML_ID_VALUE(EbmlId(element));
+  r.m_name        = EBML_NAME(&element);
+  r.m_position    = element.GetElementPosition();
+  r.m_size        = element.IsFiniteSize() ? static_cast<int64_t>(element.HeadSize() + element.GetSize()) : -1;
+  r.m_value_type  = value_type_e::none;
+  r.m_is_block    = false;
+  r.m_value.clear();
+  r.m_frame_sizes.clear();
+
+  // Blocks are binary elements, too. They must be checked first.
+  auto block = dynamic_cast<KaxInternalBlock *>(&element);
+  if (block && cluster) {
+    block->SetParent(*cluster);
+
+    // A block in a block group is a key frame if the group doesn't
+    // reference any other block.
+    auto simple_block = dynamic_cast<KaxSimpleBlock *>(block);
+    r.m_is_block      = true;
+    r.m_track         = block->TrackNum();
+    r.m_timecode      = block->GlobalTimecode();
+    r.m_keyframe      = simple_block ? simple_block->IsKeyframe() : parent && !FindChild<KaxReferenceBlock>(*parent);
+    r.m_discardable   = simple_block && simple_block->IsDiscardable();
+
+    for (auto idx = 0u; idx < block->NumberFrames(); ++idx)
+      r.m_frame_sizes.push_back(block->GetBuffer(idx).Size());
+
+    return;
+  }
+
+  if (dynamic_cast<EbmlMaster *>(&element))
+    return;
+
+  if (dynamic_cast<EbmlUInteger *>(&element)) {
+    r.m_value_type = value_type_e::number;
+    r.m_value      = std::to_string(static_cast<EbmlUInteger &>(element).GetValue());
+
+  } else if (dynamic_cast<EbmlSInteger *>(&element)) {
+    r.m_value_type = value_type_e::number;
+    r.m_value      = std::to_string(static_cast<EbmlSInteger &>(element).GetValue());
+
+  } else if (dynamic_cast<EbmlFloat *>(&element)) {
+    // JSON has no representation for infinity and NaN.
+    auto value     = static_cast<EbmlFloat &>(element).GetValue();
+    r.m_value_type = std::isfinite(value) ? value_type_e::number : value_type_e::string;
+    r.m_value      = format_float(value);
+
+  } else if (dynamic_cast<EbmlDate *>(&element)) {
+    r.m_value_type = value_type_e::number;
+    r.m_value      = std::to_string(static_cast<EbmlDate &>(element).GetEpochDate());
+
+  } else if (dynamic_cast<EbmlString *>(&element)) {
+    r.m_value_type = value_type_e::string;
+    r.m_value      = static_cast<EbmlString &>(element).GetValue();
+
+  } else if (dynamic_cast<EbmlUnicodeString *>(&element)) {
+    r.m_value_type = value_type_e::string;
+    r.m_value      = static_cast<EbmlUnicodeString &>(element).GetValueUTF8();
+
+  } else if (dynamic_cast<EbmlBinary *>(&element)) {
+    auto &binary = static_cast<EbmlBinary &>(element);
+    if (binary.GetBuffer() && (binary.GetSize() <= s_max_binary_value_size)) {
+      r.m_value_type = value_type_e::string;
+      append_hex(r.m_value, binary.GetBuffer(), binary.GetSize());
+    }
+  }
+}
+
+// JSON: one object per line. Keys that don't apply to an element are
+// omitted. An unknown size is written as null.
+
+element_writer_json_c::element_writer_json_c(mm_io_cptr const &out)
+  : element_writer_c{out}
+{
+}
+
+void
+element_writer_json_c::write_record(record_t const &record) {
+  auto &l = m_line;
+
+  l  = "{\"level\":";
+  l += std::to_string(record.m_level);
+  l += ",\"id\":\"";
+  l += format_id(record.m_id);
+  l += "\",\"name\":\"";
+  l += escape_json(record.m_name);
+  l += "\",\"position\":";
+  l += std::to_string(record.m_position);
+  l += ",\"size\":";
+  l += -1 == record.m_size ? std::string{"null"} : std::to_string(record.m_size);
+
+  if (value_type_e::number == record.m_value_type) {
+    l += ",\"value\":";
+    l += record.m_value;
+
+  } else if (value_type_e::string == record.m_value_type) {
+    l += ",\"value\":\"";
+    l += escape_json(record.m_value);
+    l += "\"";
+  }
+
+  if (record.m_is_block) {
+    l += ",\"track\":";
+    l += std::to_string(record.m_track);
+    l += ",\"timecode\":";
+    l += std::to_string(record.m_timecode);
+    l += ",\"key\":";
+    l += record.m_keyframe ? "true" : "false";
+    l += ",\"discardable\":";
+    l += record.m_discardable ? "true" : "false";
+    l += ",\"frame_sizes\":[";
+
+    for (auto idx = 0u; idx < record.m_frame_sizes.size(); ++idx) {
+      if (idx)
+        l += ',';
+      l += std::to_string(record.m_frame_sizes[idx]);
+    }
+
+    l += ']';
+  }
+
+  l += "}\n";
+
+  write(l);
+}
+
+// CSV: RFC 4180 quoting, fixed columns, empty fields for values that
+// don't apply. Flags are 'k' (key) and 'd' (discardable), frame sizes
+// are separated by spaces.
+
+element_writer_csv_c::element_writer_csv_c(mm_io_cptr const &out)
+  : element_writer_c{out}
+{
+}
+
+void
+element_writer_csv_c::write_header() {
+  write("level,id,name,position,size,value,track,timecode,flags,frame_sizes\n");
+}
+
+void
+element_writer_csv_c::add_field(std::string const &value) {
+  if (!m_line.empty())
+    m_line += ',';
+
+  if (value.find_first_of(",\"\r\n") == std::string::npos) {
+    m_line += value;
+    return;
+  }
+
+  m_line += '"';
+  for (auto c : value) {
+    if (c == '"')
+      m_line += '"';
+    m_line += c;
+  }
+  m_line += '"';
+}
+
+void
+element_writer_csv_c::write_record(record_t const &record) {
+  m_line.clear();
+
+  add_field(std::to_string(record.m_level));
+  add_field(format_id(record.m_id));
+  add_field(record.m_name);
+  add_field(std::to_string(record.m_position));
+  add_field(-1 == record.m_size ? std::string{} : std::to_string(record.m_size));
+  add_field(record.m_value);
+
+  if (record.m_is_block) {
+    std::string flags, frame_sizes;
+
+    if (record.m_keyframe)
+      flags += 'k';
+    if (record.m_discardable)
+      flags += 'd';
+
+    for (auto idx = 0u; idx < record.m_frame_sizes.size(); ++idx) {
+      if (idx)
+        frame_sizes += ' ';
+      frame_sizes += std::to_string(record.m_frame_sizes[idx]);
+    }
+
+    add_field(std::to_string(record.m_track));
+    add_field(std::to_string(record.m_timecode));
+    add_field(flags);
+    add_field(frame_sizes);
+
+  } else
+    m_line += ",,,,";
+
+  m_line += '\n';
+
+  write(m_line);
+}
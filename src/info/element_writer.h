@@ -0,0 +1,112 @@
+/*
+   mkvinfo -- info tracks from Matroska files into other files
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit http://www.gnu.org/copyleft/gpl.html
+
+   class definitions for the machine-readable output formats
+
+   Written by Moritz Bunkus <moritz@bunkus.org>.
+*/
+
+#ifndef MTX_INFO_ELEMENT_WRITER_H
+#define MTX_INFO_ELEMENT_WRITER_H
+
+#include "common/common_pch.h"
+
+#include <ebml/EbmlElement.h>
+#include <matroska/KaxCluster.h>
+
+#include "common/mm_io.h"
+
+/* Serializes the element tree as one record per element. The records
+   are assembled into a single string each and written to a large
+   output buffer; neither the translation layer nor boost::format are
+   involved. */
+
+class element_writer_c;
+using element_writer_cptr = std::shared_ptr<element_writer_c>;
+
+class element_writer_c {
+public:
+  enum class format_e {
+    none,
+    json,
+    csv,
+  };
+
+  enum class value_type_e {
+    none,
+    number,
+    string,
+  };
+
+  struct record_t {
+    unsigned int m_level;
+    uint32_t m_id;
+    char const *m_name;
+    int64_t m_position, m_size;
+    value_type_e m_value_type;
+    std::string m_value;
+
+    bool m_is_block;
+    uint64_t m_track;
+    int64_t m_timecode;
+    bool m_keyframe, m_discardable;
+    std::vector<uint64_t> m_frame_sizes;
+
+    record_t();
+  };
+
+  static size_t const s_buffer_size = 1 << 20;
+
+protected:
+  mm_io_cptr m_out;
+  record_t m_record;
+  int64_t m_timecode_scale;
+
+public:
+  element_writer_c(mm_io_cptr const &out);
+  virtual ~element_writer_c();
+
+  virtual void write_header();
+  void write_tree(EbmlElement &element, unsigned int level, KaxCluster *cluster = nullptr, EbmlMaster *parent = nullptr);
+  void flush();
+
+  static element_writer_cptr create(format_e format, mm_io_cptr const &out);
+  static format_e parse_format(std::string const &format);
+
+protected:
+  void fill_record(EbmlElement &element, unsigned int level, KaxCluster *cluster, EbmlMaster *parent);
+  void write(std::string const &text);
+
+  virtual void write_record(record_t const &record) = 0;
+};
+
+class element_writer_json_c: public element_writer_c {
+protected:
+  std::string m_line;
+
+public:
+  element_writer_json_c(mm_io_cptr const &out);
+
+protected:
+  virtual void write_record(record_t const &record);
+};
+
+class element_writer_csv_c: public element_writer_c {
+protected:
+  std::string m_line;
+
+public:
+  element_writer_csv_c(mm_io_cptr const &out);
+
+  virtual void write_header();
+
+protected:
+  virtual void write_record(record_t const &record);
+  void add_field(std::string const &value);
+};
+
+#endif // MTX_INFO_ELEMENT_WRITER_H
@@ -35,15 +35,17 @@ info_cli_parser_c::init_parser() {
   add_section_header(YT("Options"));
 
 #if defined(HAVE_QT) || defined(HAVE_WXWIDGETS)
-  OPT("g|gui",          set_gui,          YT("Start the GUI (and open inname if it was given)."));
+  OPT("g|gui",                    set_gui,           YT("Start the GUI (and open inname if it was given)."));
 #endif
-  OPT("c|checksum",     set_checksum,     YT("Calculate and display checksums of frame contents."));
-  OPT("C|check-mode",   set_check_mode,   YT("Calculate and display checksums and use verbosity level 4."));
-  OPT("s|summary",      set_summary,      YT("Only show summaries of the contents, not each element."));
-  OPT("t|track-info",   set_track_info,   YT("Show statistics for each track in verbose mode."));
-  OPT("x|hexdump",      set_hexdump,      YT("Show the first 16 bytes of each frame as a hex dump."));
-  OPT("X|full-hexdump", set_full_hexdump, YT("Show all bytes of each frame as a hex dump."));
-  OPT("z|size",         set_size,         YT("Show the size of each element including its header."));
+  OPT("c|checksum",               set_checksum,      YT("Calculate and display checksums of frame contents."));
+  OPT("C|check-mode",             set_check_mode,    YT("Calculate and display checksums and use verbosity level 4."));
+  OPT("s|summary",                set_summary,       YT("Only show summaries of the contents, not each element."));
+  OPT("t|track-info",             set_track_info,    YT("Show statistics for each track in verbose mode."));
+  OPT("S|statistics",             set_statistics,    YT("Only output statistics for each track as JSON. Frame contents are skipped unless checksums are requested."));
+  OPT("x|hexdump",                set_hexdump,       YT("Show the first 16 bytes of each frame as a hex dump."));
+  OPT("X|full-hexdump",           set_full_hexdump,  YT("Show all bytes of each frame as a hex dump."));
+  OPT("z|size",                   set_size,          YT("Show the size of each element including its header."));
+  OPT("F|output-format=<format>", set_output_format, YT("Output all elements and blocks as 'json' (one object per line) or 'csv' instead of the human-readable tree."));
 
   add_common_options();
 
@@ -101,6 +103,20 @@ info_cli_parser_c::set_track_info() {
     verbose = 1;
 }
 
+void
+info_cli_parser_c::set_statistics() {
+  m_options.m_show_statistics = true;
+}
+
+void
+info_cli_parser_c::set_output_format() {
+  try {
+    m_options.m_output_format = element_writer_c::parse_format(m_next_arg);
+  } catch (...) {
+    mxerror(boost::format(Y("Unknown output format in '%1% %2%'.\n")) % m_current_arg % m_next_arg);
+  }
+}
+
 void
 info_cli_parser_c::set_file_name() {
   if (!m_options.m_file_name.empty())
@@ -38,6 +38,8 @@ protected:
   void set_size();
   void set_file_name();
   void set_track_info();
+  void set_statistics();
+  void set_output_format();
 };
 
 #endif // MTX_INFO_INFO_CLI_PARSER_H
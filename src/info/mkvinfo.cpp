@@ -62,6 +62,8 @@
 #include "common/kax_file.h"
 #include "common/mm_io.h"
 #include "common/mm_io_x.h"
+#include "common/mm_read_buffer_io.h"
+#include "common/mm_write_buffer_io.h"
 #include "common/mpeg4_p10.h"
 #include "common/stereo_mode.h"
 #include "common/strings/editing.h"
@@ -70,11 +72,14 @@
 #include "common/version.h"
 #include "common/xml/ebml_chapters_converter.h"
 #include "common/xml/ebml_tags_converter.h"
+#include "info/element_writer.h"
 #include "info/mkvinfo.h"
 #include "info/info_cli_parser.h"
 
 using namespace libmatroska;
 
+extern bool g_warning_issued;
+
 struct kax_track_t {
   uint64_t tnum, tuid;
   char type;
@@ -267,7 +272,7 @@ _show_element(EbmlElement *l,
               bool skip,
               int level,
               const std::string &info) {
-  if (g_options.m_show_summary)
+  if (g_options.m_show_summary || g_options.m_show_statistics)
     return;
 
   ui_show_element(level, info,
@@ -1158,7 +1163,7 @@ handle_block_group(EbmlStream *&es,
 
       for (size_t i = 0; i < block.NumberFrames(); ++i) {
         auto &data = block.GetBuffer(i);
-        auto adler = mtx::checksum::calculate_as_uint(mtx::checksum::algorithm_e::adler32, data.Buffer(), data.Size());
+        auto adler = g_options.m_calc_checksums ? mtx::checksum::calculate_as_uint(mtx::checksum::algorithm_e::adler32, data.Buffer(), data.Size()) : 0;
 
         std::string adler_str;
         if (g_options.m_calc_checksums)
@@ -1355,7 +1360,7 @@ handle_simple_block(EbmlStream *&es,
   int i;
   for (i = 0; i < (int)block.NumberFrames(); i++) {
     DataBuffer &data = block.GetBuffer(i);
-    uint32_t adler   = mtx::checksum::calculate_as_uint(mtx::checksum::algorithm_e::adler32, data.Buffer(), data.Size());
+    uint32_t adler   = g_options.m_calc_checksums ? mtx::checksum::calculate_as_uint(mtx::checksum::algorithm_e::adler32, data.Buffer(), data.Size()) : 0;
 
     std::string adler_str;
     if (g_options.m_calc_checksums)
@@ -1560,6 +1565,267 @@ handle_ebml_head(EbmlElement *l0,
   }
 }
 
+// Statistics mode: clusters are scanned with a minimal EBML parser
+// instead of libebml. Only element and block headers are read; the
+// frame contents are skipped unless checksums have been requested.
+
+namespace {
+
+struct statistics_element_t {
+  uint32_t m_id;
+  int64_t m_data_start, m_data_end;
+  bool m_unknown_size;
+};
+
+struct statistics_block_t {
+  unsigned int m_track_number, m_num_frames;
+  int64_t m_relative_timecode, m_data_start, m_data_end;
+  bool m_keyframe, m_discardable;
+};
+
+std::map<unsigned int, mtx::checksum::base_uptr> s_track_checksums;
+
+bool
+read_statistics_element_head(mm_io_c &in,
+                             int64_t parent_end,
+                             statistics_element_t &element) {
+  if (in.getFilePointer() >= static_cast<uint64_t>(parent_end))
+    return false;
+
+  auto id   = vint_c::read_ebml_id(&in);
+  auto size = vint_c::read(&in);
+
+  if (!id.is_valid() || !size.is_valid())
+    return false;
+
+  element.m_id           = id.m_value;
+  element.m_data_start   = in.getFilePointer();
+  element.m_unknown_size = size.is_unknown();
+  element.m_data_end     = element.m_unknown_size ? parent_end : std::min(parent_end, element.m_data_start + size.m_value);
+
+  return true;
+}
+
+uint64_t
+read_statistics_uint(mm_io_c &in,
+                     statistics_element_t const &element) {
+  uint64_t value = 0;
+  for (auto idx = element.m_data_start; idx < std::min(element.m_data_end, element.m_data_start + 8); ++idx)
+    value = (value << 8) | in.read_uint8();
+
+  return value;
+}
+
+bool
+read_statistics_block_head(mm_io_c &in,
+                           statistics_element_t const &element,
+                           statistics_block_t &block) {
+  auto track_number = vint_c::read(&in);
+  if (!track_number.is_valid() || ((in.getFilePointer() + 3) > static_cast<uint64_t>(element.m_data_end)))
+    return false;
+
+  block.m_track_number      = track_number.m_value;
+  block.m_relative_timecode = static_cast<int16_t>(in.read_uint16_be());
+
+  auto flags                = in.read_uint8();
+  auto lacing               = (flags >> 1) & 0x03;
+  block.m_keyframe          = 0x80 == (flags & 0x80);
+  block.m_discardable       = 0x01 == (flags & 0x01);
+  block.m_num_frames        = lacing ? in.read_uint8() + 1 : 1;
+
+  // The lace sizes themselves aren't needed, only where the frame
+  // data starts.
+  for (auto idx = 1u; idx < block.m_num_frames; ++idx)
+    if (1 == lacing) {
+      while (in.read_uint8() == 0xff)
+        ;
+
+    } else if ((3 == lacing) && !vint_c::read(&in).is_valid())
+      return false;
+
+  block.m_data_start = in.getFilePointer();
+  block.m_data_end   = element.m_data_end;
+
+  return block.m_data_start <= block.m_data_end;
+}
+
+void
+add_block_statistics(mm_io_c &in,
+                     statistics_block_t const &block,
+                     int64_t cluster_timecode,
+                     unsigned int ref_idx,
+                     int64_t duration) {
+  auto &tinfo   = s_track_info[block.m_track_number];
+  auto timecode = (cluster_timecode + block.m_relative_timecode) * static_cast<int64_t>(s_tc_scale);
+
+  tinfo.m_blocks                     += block.m_num_frames;
+  tinfo.m_blocks_by_ref_num[ref_idx] += block.m_num_frames;
+  tinfo.m_min_timecode                = std::min(tinfo.m_min_timecode, timecode);
+  tinfo.m_size                       += block.m_data_end - block.m_data_start;
+
+  if (tinfo.max_timecode_unset() || (tinfo.m_max_timecode < timecode)) {
+    tinfo.m_max_timecode               = timecode;
+    tinfo.m_add_duration_for_n_packets = -1 == duration ? block.m_num_frames : 0;
+    if (-1 != duration)
+      tinfo.m_max_timecode            += duration;
+  }
+
+  if (!g_options.m_calc_checksums)
+    return;
+
+  static auto s_buffer = memory_c::alloc(64 * 1024);
+
+  auto &checksum = s_track_checksums[block.m_track_number];
+  if (!checksum)
+    checksum = mtx::checksum::for_algorithm(mtx::checksum::algorithm_e::adler32);
+
+  in.setFilePointer(block.m_data_start);
+
+  auto remaining = block.m_data_end - block.m_data_start;
+  while (remaining) {
+    auto num_read = in.read(s_buffer->get_buffer(), std::min<int64_t>(remaining, s_buffer->get_size()));
+    if (!num_read)
+      break;
+
+    checksum->add(s_buffer->get_buffer(), num_read);
+    remaining -= num_read;
+  }
+}
+
+void
+scan_block_group_for_statistics(mm_io_c &in,
+                                statistics_element_t const &group,
+                                int64_t cluster_timecode) {
+  statistics_block_t block;
+  statistics_element_t child;
+  auto have_block     = false;
+  auto num_references = 0u;
+  int64_t duration    = -1;
+
+  while (read_statistics_element_head(in, group.m_data_end, child) && !child.m_unknown_size) {
+    if (EBML_ID_VALUE(EBML_ID(KaxBlock)) == child.m_id)
+      have_block = read_statistics_block_head(in, child, block);
+
+    else if (EBML_ID_VALUE(EBML_ID(KaxBlockDuration)) == child.m_id)
+      duration = read_statistics_uint(in, child) * s_tc_scale;
+
+    else if (EBML_ID_VALUE(EBML_ID(KaxReferenceBlock)) == child.m_id)
+      ++num_references;
+
+    in.setFilePointer(child.m_data_end);
+  }
+
+  if (have_block)
+    add_block_statistics(in, block, cluster_timecode, std::min(num_references, 2u), duration);
+}
+
+}
+
+/** \brief Handle the next level 1 element in statistics mode
+
+   Clusters are scanned for statistics, and elements that aren't
+   needed for them are skipped without being read.
+
+   \return \c false if the element must be handled by libebml instead
+     (the segment info and the tracks, invalid elements).
+*/
+bool
+handle_level1_element_for_statistics(mm_io_c &in,
+                                     kax_file_c &kax_file,
+                                     int64_t segment_end) {
+  auto element_start = in.getFilePointer();
+  statistics_element_t element;
+
+  if (   !read_statistics_element_head(in, segment_end, element)
+      || (EBML_ID_VALUE(EBML_ID(KaxInfo))   == element.m_id)
+      || (EBML_ID_VALUE(EBML_ID(KaxTracks)) == element.m_id)
+      || (element.m_unknown_size && (EBML_ID_VALUE(EBML_ID(KaxCluster)) != element.m_id))) {
+    in.setFilePointer(element_start);
+    return false;
+  }
+
+  if (EBML_ID_VALUE(EBML_ID(KaxCluster)) != element.m_id) {
+    in.setFilePointer(element.m_data_end);
+    return true;
+  }
+
+  int64_t cluster_timecode = 0;
+
+  try {
+    while (true) {
+      auto child_start = in.getFilePointer();
+      statistics_element_t child;
+
+      if (!read_statistics_element_head(in, element.m_data_end, child))
+        break;
+
+      // A cluster with an unknown size ends where the next level 1
+      // element starts.
+      if (element.m_unknown_size && kax_file.is_level1_element_id(vint_c{child.m_id, 4})) {
+        in.setFilePointer(child_start);
+        return true;
+      }
+
+      if (child.m_unknown_size)
+        break;
+
+      if (EBML_ID_VALUE(EBML_ID(KaxClusterTimecode)) == child.m_id)
+        cluster_timecode = read_statistics_uint(in, child);
+
+      else if (EBML_ID_VALUE(EBML_ID(KaxSimpleBlock)) == child.m_id) {
+        statistics_block_t block;
+        if (read_statistics_block_head(in, child, block))
+          add_block_statistics(in, block, cluster_timecode, block.m_keyframe ? 0 : block.m_discardable ? 2 : 1, -1);
+
+      } else if (EBML_ID_VALUE(EBML_ID(KaxBlockGroup)) == child.m_id)
+        scan_block_group_for_statistics(in, child, cluster_timecode);
+
+      in.setFilePointer(child.m_data_end);
+    }
+
+  } catch (mtx::mm_io::exception &) {
+  }
+
+  in.setFilePointer(element.m_data_end);
+
+  return true;
+}
+
+void
+display_track_statistics() {
+  for (auto &track : s_tracks) {
+    auto &tinfo = s_track_info[track->tnum];
+
+    if (tinfo.min_timecode_unset())
+      tinfo.m_min_timecode = 0;
+    if (tinfo.max_timecode_unset())
+      tinfo.m_max_timecode = tinfo.m_min_timecode;
+
+    int64_t duration  = tinfo.m_max_timecode - tinfo.m_min_timecode;
+    duration         += tinfo.m_add_duration_for_n_packets * track->default_duration;
+
+    auto type         =  'a' == track->type ? "audio"
+                       : 'v' == track->type ? "video"
+                       : 's' == track->type ? "subtitles"
+                       : 'b' == track->type ? "buttons"
+                       :                      "unknown";
+    auto &checksum    = s_track_checksums[track->tnum];
+    auto adler32      = !checksum ? std::string{} : (boost::format(",\"adler32\":\"0x%|1$08x|\"") % dynamic_cast<mtx::checksum::uint_result_c &>(checksum->finish()).get_result_as_uint()).str();
+
+    mxinfo(boost::format("{\"track\":%1%,\"type\":\"%2%\",\"blocks\":%3%,\"key_blocks\":%4%,\"size\":%5%,\"min_timecode\":%6%,\"max_timecode\":%7%,\"duration\":%8%,\"bitrate\":%9%%10%}\n")
+           % track->tnum
+           % type
+           % tinfo.m_blocks
+           % tinfo.m_blocks_by_ref_num[0]
+           % tinfo.m_size
+           % tinfo.m_min_timecode
+           % tinfo.m_max_timecode
+           % duration
+           % static_cast<uint64_t>(duration == 0 ? 0 : tinfo.m_size * 8000000000.0 / duration)
+           % adler32);
+  }
+}
+
 void
 display_track_info() {
   if (!g_options.m_show_track_info)
@@ -1585,6 +1851,92 @@ display_track_info() {
   }
 }
 
+/** \brief Shows messages on stderr instead of stdout
+
+   Used while the elements are written to stdout in one of the
+   machine-readable formats. Messages, e.g. about resyncing after
+   errors in the file structure, must not end up in that output.
+*/
+static void
+show_message_on_stderr(unsigned int level,
+                       std::string const &message) {
+  auto text = MXMSG_WARNING == level ? std::string{Y("Warning: ")} + message : message;
+
+  fputs(g_cc_stdio->native(text).c_str(), stderr);
+  fflush(stderr);
+
+  if (MXMSG_WARNING == level)
+    g_warning_issued = true;
+}
+
+/** \brief Output all elements in one of the machine-readable formats
+
+   Each level 1 element is read completely and handed to the element
+   writer which serializes the whole tree including block summaries.
+   Nothing goes through the human-readable formatting functions.
+*/
+bool
+write_elements(mm_io_cptr in) {
+  auto out    = mm_io_cptr{new mm_write_buffer_io_c(g_mm_stdio.get(), element_writer_c::s_buffer_size, false)};
+  auto writer = element_writer_c::create(g_options.m_output_format, out);
+  EbmlStream es(*in);
+
+  set_mxmsg_handler(MXMSG_INFO,    show_message_on_stderr);
+  set_mxmsg_handler(MXMSG_WARNING, show_message_on_stderr);
+
+  writer->write_header();
+
+  auto l0 = std::unique_ptr<EbmlElement>{es.FindNextID(EBML_INFO(EbmlHead), 0xFFFFFFFFL)};
+  if (!l0 || !Is<EbmlHead>(*l0)) {
+    show_error(Y("No EBML head found."));
+    return false;
+  }
+
+  int upper_lvl_el           = 0;
+  EbmlElement *element_found = nullptr;
+  l0->Read(es, EBML_CONTEXT(l0), upper_lvl_el, element_found, true);
+  delete element_found;
+
+  writer->write_tree(*l0, 0);
+  in->setFilePointer(l0->GetElementPosition() + l0->HeadSize() + l0->GetSize());
+
+  while (true) {
+    l0.reset(es.FindNextID(EBML_INFO(KaxSegment), 0xFFFFFFFFFFFFFFFFLL));
+    if (!l0) {
+      show_error(Y("No segment/level 0 element found."));
+      return false;
+    }
+
+    writer->write_tree(*l0, 0);
+
+    if (Is<KaxSegment>(*l0))
+      break;
+
+    l0->SkipData(es, EBML_CONTEXT(l0));
+  }
+
+  kax_file_c kax_file(in);
+
+  // Prevent reporting "first timecode after resync":
+  kax_file.set_timecode_scale(-1);
+
+  EbmlElement *l1;
+  while ((l1 = kax_file.read_next_level1_element())) {
+    std::unique_ptr<EbmlElement> af_l1(l1);
+
+    writer->write_tree(*l1, 1);
+
+    if (!in->setFilePointer2(l1->GetElementPosition() + kax_file.get_element_size(l1)))
+      break;
+    if (!in_parent(l0))
+      break;
+  }
+
+  writer->flush();
+
+  return true;
+}
+
 bool
 process_file(const std::string &file_name) {
   int upper_lvl_el;
@@ -1595,11 +1947,18 @@ process_file(const std::string &file_name) {
   s_tracks.clear();
   s_tracks_by_number.clear();
   s_track_info.clear();
+  s_track_checksums.clear();
 
   // open input file
   mm_io_cptr in;
   try {
-    in = mm_file_io_c::open(file_name);
+    // In statistics mode most of the file is skipped in small steps,
+    // and the machine-readable formats read every element. The read
+    // buffer avoids seeking in the file for each of them.
+    if (g_options.m_show_statistics || (element_writer_c::format_e::none != g_options.m_output_format))
+      in = mm_io_cptr(new mm_read_buffer_io_c(new mm_file_io_c(file_name), 1 << 17));
+    else
+      in = mm_file_io_c::open(file_name);
   } catch (mtx::mm_io::exception &ex) {
     show_error((boost::format(Y("Error: Couldn't open input file %1% (%2%).\n")) % file_name % ex).str());
     return false;
@@ -1609,6 +1968,15 @@ process_file(const std::string &file_name) {
   uint64_t file_size = in->getFilePointer();
   in->setFilePointer(0, seek_beginning);
 
+  if (!g_options.m_use_gui && (element_writer_c::format_e::none != g_options.m_output_format)) {
+    try {
+      return write_elements(in);
+    } catch (...) {
+      show_error(Y("Caught exception"));
+      return false;
+    }
+  }
+
   try {
     EbmlStream *es = new EbmlStream(*in);
 
@@ -1652,7 +2020,19 @@ process_file(const std::string &file_name) {
     // Prevent reporting "first timecode after resync":
     kax_file->set_timecode_scale(-1);
 
-    while ((l1 = kax_file->read_next_level1_element())) {
+    auto segment_end = l0->IsFiniteSize() ? static_cast<int64_t>(l0->GetElementPosition() + l0->HeadSize() + l0->GetSize()) : static_cast<int64_t>(file_size);
+
+    while (true) {
+      if (g_options.m_show_statistics && handle_level1_element_for_statistics(*in, *kax_file, segment_end)) {
+        if (!in_parent(l0))
+          break;
+        continue;
+      }
+
+      l1 = kax_file->read_next_level1_element();
+      if (!l1)
+        break;
+
       std::shared_ptr<EbmlElement> af_l1(l1);
 
       if (Is<KaxInfo>(l1))
@@ -1666,7 +2046,7 @@ process_file(const std::string &file_name) {
 
       else if (Is<KaxCluster>(l1)) {
         show_element(l1, 1, Y("Cluster"));
-        if ((g_options.m_verbose == 0) && !g_options.m_show_summary) {
+        if ((g_options.m_verbose == 0) && !g_options.m_show_summary && !g_options.m_show_statistics) {
           delete l0;
           delete es;
 
@@ -1700,7 +2080,10 @@ process_file(const std::string &file_name) {
     delete l0;
     delete es;
 
-    if (!g_options.m_use_gui && g_options.m_show_track_info)
+    if (!g_options.m_use_gui && g_options.m_show_statistics)
+      display_track_statistics();
+
+    else if (!g_options.m_use_gui && g_options.m_show_track_info)
       display_track_info();
 
     return true;
@@ -20,7 +20,9 @@ options_c::options_c()
   , m_show_hexdump(false)
   , m_show_size(false)
   , m_show_track_info(false)
+  , m_show_statistics(false)
   , m_hexdump_max_size(16)
   , m_verbose(0)
+  , m_output_format(element_writer_c::format_e::none)
 {
 }
@@ -13,11 +13,14 @@
 
 #include "common/common_pch.h"
 
+#include "info/element_writer.h"
+
 class options_c {
 public:
   std::string m_file_name;
-  bool m_use_gui, m_calc_checksums, m_show_summary, m_show_hexdump, m_show_size, m_show_track_info;
+  bool m_use_gui, m_calc_checksums, m_show_summary, m_show_hexdump, m_show_size, m_show_track_info, m_show_statistics;
   int m_hexdump_max_size, m_verbose;
+  element_writer_c::format_e m_output_format;
 public:
   options_c();
 };
@@ -0,0 +1,202 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit http://www.gnu.org/copyleft/gpl.html
+
+   Ogg page scanner
+
+   Written by Moritz Bunkus <moritz@bunkus.org>.
+*/
+
+#include "common/common_pch.h"
+
+#include "common/endian.h"
+#include "input/ogg_page_scanner.h"
+
+namespace {
+
+size_t const s_header_size     = 27;
+size_t const s_crc_offset      = 22;
+size_t const s_max_header_size = s_header_size + 255;
+size_t const s_max_page_size   = s_max_header_size + 255 * 255;
+
+// Ogg's CRC: polynomial 0x04c11db7, initial value 0, not reflected,
+// no final XOR. The tables allow processing eight bytes per step
+// ("slicing-by-8").
+class crc_tables_c {
+public:
+  uint32_t m_tables[8][256];
+
+public:
+  crc_tables_c() {
+    for (auto i = 0u; i < 256u; ++i) {
+      uint32_t crc = i << 24;
+      for (auto bit = 0u; bit < 8u; ++bit)
+        crc = (crc & 0x80000000u) ? (crc << 1) ^ 0x04c11db7u : (crc << 1);
+      m_tables[0][i] = crc;
+    }
+
+    for (auto i = 0u; i < 256u; ++i)
+      for (auto slice = 1u; slice < 8u; ++slice)
+        m_tables[slice][i] = (m_tables[slice - 1][i] << 8) ^ m_tables[0][m_tables[slice - 1][i] >> 24];
+  }
+
+  uint32_t
+  update(uint32_t crc,
+         unsigned char const *buffer,
+         size_t size)
+    const {
+    auto const &t = m_tables;
+
+    while (size >= 8) {
+      auto one  = crc ^ get_uint32_be(buffer);
+      auto two  = get_uint32_be(buffer + 4);
+
+      crc       = t[7][ one >> 24        ] ^ t[6][(one >> 16) & 0xff] ^ t[5][(one >> 8) & 0xff] ^ t[4][one & 0xff]
+                ^ t[3][ two >> 24        ] ^ t[2][(two >> 16) & 0xff] ^ t[1][(two >> 8) & 0xff] ^ t[0][two & 0xff];
+
+      buffer   += 8;
+      size     -= 8;
+    }
+
+    while (size) {
+      crc = (crc << 8) ^ t[0][(crc >> 24) ^ *buffer];
+      ++buffer;
+      --size;
+    }
+
+    return crc;
+  }
+};
+
+crc_tables_c const &
+crc_tables() {
+  static crc_tables_c s_tables;
+  return s_tables;
+}
+
+}
+
+ogg_page_scanner_c::ogg_page_scanner_c(mm_io_c &in,
+                                       size_t window_size)
+  : m_in(in)
+  , m_window{memory_c::alloc(std::max(window_size, s_max_page_size))}
+  , m_window_start{}
+  , m_window_end{}
+  , m_num_skipped_bytes{}
+  , m_eof{}
+{
+}
+
+uint32_t
+ogg_page_scanner_c::calculate_crc(unsigned char const *header,
+                                  size_t header_len,
+                                  unsigned char const *body,
+                                  size_t body_len) {
+  static unsigned char const s_zero_crc[4] = { 0, 0, 0, 0 };
+
+  // The CRC is calculated with the CRC field itself set to 0.
+  auto &tables = crc_tables();
+  auto crc     = tables.update(0,   header,                    s_crc_offset);
+  crc          = tables.update(crc, s_zero_crc,                4);
+  crc          = tables.update(crc, header + s_crc_offset + 4, header_len - s_crc_offset - 4);
+
+  return tables.update(crc, body, body_len);
+}
+
+void
+ogg_page_scanner_c::reset() {
+  m_window_start      = 0;
+  m_window_end        = 0;
+  m_num_skipped_bytes = 0;
+  m_eof               = false;
+}
+
+void
+ogg_page_scanner_c::skip(size_t num_bytes) {
+  m_window_start      += num_bytes;
+  m_num_skipped_bytes += num_bytes;
+}
+
+bool
+ogg_page_scanner_c::ensure_available(size_t num_bytes) {
+  while ((m_window_end - m_window_start) < num_bytes) {
+    if (m_eof)
+      return false;
+
+    auto buffer    = m_window->get_buffer();
+    auto available = m_window_end - m_window_start;
+
+    if (m_window_start) {
+      if (available)
+        memmove(buffer, buffer + m_window_start, available);
+      m_window_start = 0;
+      m_window_end   = available;
+    }
+
+    auto num_read = m_in.read(buffer + m_window_end, m_window->get_size() - m_window_end);
+    if (!num_read)
+      m_eof = true;
+
+    m_window_end += num_read;
+  }
+
+  return true;
+}
+
+bool
+ogg_page_scanner_c::read_page(ogg_page &page) {
+  m_num_skipped_bytes = 0;
+
+  while (true) {
+    if (!ensure_available(s_header_size))
+      return false;
+
+    auto start     = m_window->get_buffer() + m_window_start;
+    auto available = m_window_end - m_window_start;
+
+    if (memcmp(start, "OggS", 4)) {
+      // Skip ahead to the next possible capture pattern.
+      auto next = static_cast<unsigned char *>(memchr(start + 1, 'O', available - 1));
+      skip(next ? next - start : available);
+      continue;
+    }
+
+    if (start[4] != 0) {
+      skip(1);
+      continue;
+    }
+
+    auto header_len = s_header_size + start[26];
+    if (!ensure_available(header_len))
+      return false;
+
+    start          = m_window->get_buffer() + m_window_start;
+    auto body_len  = 0u;
+    for (auto idx = 0u; idx < start[26]; ++idx)
+      body_len    += start[s_header_size + idx];
+
+    if (!ensure_available(header_len + body_len))
+      return false;
+
+    start     = m_window->get_buffer() + m_window_start;
+    auto body = start + header_len;
+
+    if (get_uint32_le(start + s_crc_offset) != calculate_crc(start, header_len, body, body_len)) {
+      skip(1);
+      continue;
+    }
+
+    page.header     = start;
+    page.header_len = header_len;
+    page.body       = body;
+    page.body_len   = body_len;
+
+    m_window_start += header_len + body_len;
+
+    return true;
+  }
+}
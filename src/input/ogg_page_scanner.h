@@ -0,0 +1,58 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit http://www.gnu.org/copyleft/gpl.html
+
+   class definitions for the Ogg page scanner
+
+   Written by Moritz Bunkus <moritz@bunkus.org>.
+*/
+
+#ifndef MTX_INPUT_OGG_PAGE_SCANNER_H
+#define MTX_INPUT_OGG_PAGE_SCANNER_H
+
+#include "common/common_pch.h"
+
+#include <ogg/ogg.h>
+
+#include "common/mm_io.h"
+
+/* Locates Ogg pages in large read-ahead windows instead of feeding
+   libogg's ogg_sync_state in small chunks. Pages returned by
+   read_page() point directly into the scanner's window and are only
+   valid until the next call to read_page() or reset(). */
+
+class ogg_page_scanner_c {
+public:
+  static size_t const s_default_window_size = 1024 * 1024;
+
+protected:
+  mm_io_c &m_in;
+  memory_cptr m_window;
+  size_t m_window_start, m_window_end;
+  uint64_t m_num_skipped_bytes;
+  bool m_eof;
+
+public:
+  ogg_page_scanner_c(mm_io_c &in, size_t window_size = s_default_window_size);
+
+  bool read_page(ogg_page &page);
+  void reset();
+
+  uint64_t get_num_skipped_bytes() const {
+    return m_num_skipped_bytes;
+  }
+
+  static uint32_t calculate_crc(unsigned char const *header, size_t header_len, unsigned char const *body, size_t body_len);
+
+protected:
+  bool ensure_available(size_t num_bytes);
+  void skip(size_t num_bytes);
+};
+
+using ogg_page_scanner_cptr = std::shared_ptr<ogg_page_scanner_c>;
+
+#endif  // MTX_INPUT_OGG_PAGE_SCANNER_H
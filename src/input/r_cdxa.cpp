@@ -36,6 +36,9 @@ cdxa_reader_c::probe_file(mm_io_c *in,
       return true;
     }
 
+  } catch (mtx::input::unsupported_container_x &) {
+    throw;
+
   } catch (...) {
   }
 
@@ -69,6 +69,9 @@ dv_reader_c::probe_file(mm_io_c *in,
       return 1;
     }
 
+  } catch (mtx::input::unsupported_container_x &) {
+    throw;
+
   } catch (...) {
   }
 
@@ -40,6 +40,9 @@ hdsub_reader_c::probe_file(mm_io_c *in,
 
     return 0;
 
+  } catch (mtx::input::unsupported_container_x &) {
+    throw;
+
   } catch (...) {
     return 0;
   }
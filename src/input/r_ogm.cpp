@@ -48,8 +48,6 @@
 #include "output/p_vorbis.h"
 #include "output/p_vpx.h"
 
-#define BUFFER_SIZE 4096
-
 struct ogm_frame_t {
   memory_c *mem;
   int64_t duration;
@@ -294,7 +292,7 @@ ogm_reader_c::probe_file(mm_io_c *in,
 }
 
 /*
-   Opens the file for processing, initializes an ogg_sync_state used for
+   Opens the file for processing, initializes the page scanner used for
    reading from an OGG stream.
 */
 ogm_reader_c::ogm_reader_c(const track_info_c &ti,
@@ -308,7 +306,7 @@ ogm_reader_c::read_headers() {
   if (!ogm_reader_c::probe_file(m_in.get(), m_size))
     throw mtx::input::invalid_format_x();
 
-  ogg_sync_init(&oy);
+  m_page_scanner = std::make_shared<ogg_page_scanner_c>(*m_in);
 
   show_demuxer_info();
 
@@ -318,7 +316,6 @@ ogm_reader_c::read_headers() {
 }
 
 ogm_reader_c::~ogm_reader_c() {
-  ogg_sync_clear(&oy);
 }
 
 ogm_demuxer_cptr
@@ -341,31 +338,13 @@ ogm_reader_c::find_demuxer(int serialno) {
 */
 int
 ogm_reader_c::read_page(ogg_page *og) {
-  int np, done, nread;
-  unsigned char *buf;
-
-  done = 0;
-  while (!done) {
-    np = ogg_sync_pageseek(&oy, og);
-
-    // np == 0 means that there is not enough data for a complete page.
-    if (0 >= np) {
-      // np < 0 is the error case. Should not happen with local OGG files.
-      if (0 > np)
-        mxwarn_fn(m_ti.m_fname, Y("Could not find the next Ogg page. This indicates a damaged Ogg/Ogm file. Will try to continue.\n"));
-
-      buf = (unsigned char *)ogg_sync_buffer(&oy, BUFFER_SIZE);
-      if (!buf)
-        mxerror_fn(m_ti.m_fname, Y("ogg_sync_buffer failed\n"));
-
-      if (0 >= (nread = m_in->read(buf, BUFFER_SIZE)))
-        return 0;
+  if (!m_page_scanner->read_page(*og))
+    return 0;
 
-      ogg_sync_wrote(&oy, nread);
-    } else
-      // Alright, we have a page.
-      done = 1;
-  }
+  // Skipped bytes mean that the scanner had to resync. Should not happen
+  // with local OGG files.
+  if (m_page_scanner->get_num_skipped_bytes())
+    mxwarn_fn(m_ti.m_fname, Y("Could not find the next Ogg page. This indicates a damaged Ogg/Ogm file. Will try to continue.\n"));
 
   // Here EMOREDATA actually indicates success - a page has been read.
   return FILE_STATUS_MOREDATA;
@@ -641,8 +620,7 @@ ogm_reader_c::read_headers_internal() {
   }
 
   m_in->setFilePointer(0, seek_beginning);
-  ogg_sync_clear(&oy);
-  ogg_sync_init(&oy);
+  m_page_scanner->reset();
 
   return 1;
 }
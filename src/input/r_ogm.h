@@ -20,6 +20,7 @@
 
 #include "common/codec.h"
 #include "common/mm_io.h"
+#include "input/ogg_page_scanner.h"
 #include "merge/generic_reader.h"
 #include "common/theora.h"
 #include "common/kate.h"
@@ -77,7 +78,7 @@ using ogm_demuxer_cptr = std::shared_ptr<ogm_demuxer_c>;
 
 class ogm_reader_c: public generic_reader_c {
 private:
-  ogg_sync_state oy;
+  ogg_page_scanner_cptr m_page_scanner;
   std::vector<ogm_demuxer_cptr> sdemuxers;
   int bos_pages_read;
 
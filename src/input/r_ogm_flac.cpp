@@ -21,8 +21,6 @@
 #include "input/r_ogm.h"
 #include "input/r_ogm_flac.h"
 
-#define BUFFER_SIZE 4096
-
 static FLAC__StreamDecoderReadStatus
 fhe_read_cb(const FLAC__StreamDecoder *,
             FLAC__byte buffer[],
@@ -131,16 +129,16 @@ flac_header_extractor_c::flac_header_extractor_c(const std::string &file_name,
   if (FLAC__stream_decoder_init_stream(decoder, fhe_read_cb, nullptr, nullptr, nullptr, nullptr, fhe_write_cb, fhe_metadata_cb, fhe_error_cb, this) != FLAC__STREAM_DECODER_INIT_STATUS_OK)
     mxerror(Y("flac_header_extraction: Could not initialize the FLAC decoder.\n"));
 
-  ogg_sync_init(&oy);
+  page_scanner = std::make_shared<ogg_page_scanner_c>(*file);
 }
 
 flac_header_extractor_c::~flac_header_extractor_c() {
   FLAC__stream_decoder_reset(decoder);
   FLAC__stream_decoder_delete(decoder);
 
-  ogg_sync_clear(&oy);
   ogg_stream_clear(&os);
 
+  page_scanner.reset();
   delete file;
 }
 
@@ -162,23 +160,10 @@ flac_header_extractor_c::extract() {
 bool
 flac_header_extractor_c::read_page() {
   while (1) {
-    int np = ogg_sync_pageseek(&oy, &og);
-
-    if (np <= 0) {
-      if (np < 0)
-        return false;
-
-      unsigned char *buf = (unsigned char *)ogg_sync_buffer(&oy, BUFFER_SIZE);
-      if (!buf)
-        return false;
-
-      int nread;
-      if ((nread = file->read(buf, BUFFER_SIZE)) <= 0)
-        return false;
-
-      ogg_sync_wrote(&oy, nread);
+    if (!page_scanner->read_page(og) || page_scanner->get_num_skipped_bytes())
+      return false;
 
-    } else if (ogg_page_serialno(&og) == sid)
+    if (ogg_page_serialno(&og) == sid)
       break;
   }
 
@@ -22,6 +22,7 @@
 #include <FLAC/stream_decoder.h>
 
 #include "common/mm_io.h"
+#include "input/ogg_page_scanner.h"
 
 enum oggflac_mode_e {
   ofm_pre_1_1_1,
@@ -35,7 +36,7 @@ public:
   int channels, sample_rate, bits_per_sample;
   mm_io_c *file;
   ogg_stream_state os;
-  ogg_sync_state oy;
+  ogg_page_scanner_cptr page_scanner;
   ogg_page og;
   int64_t sid, num_packets, num_header_packets;
   bool done;
@@ -406,7 +406,12 @@ wav_pcm_demuxer_c::process(int64_t len) {
   if (0 >= len)
     return;
 
-  m_ptzr->process(new packet_t(new memory_c(m_buffer->get_buffer(), len, false)));
+  // Hand the buffer over to the packetizer so that it can use it for
+  // its packets without copying the data.
+  m_buffer->set_size(len);
+  m_ptzr->process(new packet_t(m_buffer));
+
+  m_buffer = memory_c::alloc(m_bps);
 }
 
 // ----------------------------------------------------------
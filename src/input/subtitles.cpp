@@ -15,9 +15,11 @@
 
 #include "common/endian.h"
 #include "common/extern_data.h"
+#include "common/hacks.h"
 #include "common/mm_io.h"
 #include "common/strings/formatting.h"
 #include "common/strings/parsing.h"
+#include "common/text_subtitles.h"
 #include "input/subtitles.h"
 #include "merge/file_status.h"
 #include "merge/input_x.h"
@@ -44,6 +46,93 @@ subtitles_c::process(generic_packetizer_c *p) {
 #define SRT_RE_TIMECODE_LINE "^" SRT_RE_TIMECODE "\\s*[\\-\\s]+>\\s*" SRT_RE_TIMECODE "\\s*"
 #define SRT_RE_COORDINATES   "([XY]\\d+:\\d+\\s*){4}\\s*$"
 
+// The regular expressions are only used if the user requests the old
+// parsers. mtx::text_subtitles accepts the same lines.
+
+static bool
+parse_srt_timecode_line_with_regex(std::string const &s,
+                                   int64_t &start,
+                                   int64_t &end) {
+  static boost::regex s_timecode_re(SRT_RE_TIMECODE_LINE, boost::regex::perl);
+
+  boost::smatch matches;
+  if (!boost::regex_search(s, matches, s_timecode_re))
+    return false;
+
+  int s_h = 0, s_min = 0, s_sec = 0, e_h = 0, e_min = 0, e_sec = 0;
+
+  //        1         2       3      4        5     6             7    8
+  // "\\s*(-?)\\s*(\\d+):\\s(-?)*(\\d+):\\s*(-?)(\\d+)[,\\.]\\s*(-?)(\\d+)?"
+
+  parse_number(matches[ 2].str(), s_h);
+  parse_number(matches[ 4].str(), s_min);
+  parse_number(matches[ 6].str(), s_sec);
+  parse_number(matches[10].str(), e_h);
+  parse_number(matches[12].str(), e_min);
+  parse_number(matches[14].str(), e_sec);
+
+  std::string s_rest = matches[ 8].str();
+  std::string e_rest = matches[16].str();
+
+  auto neg_calculator = [&](size_t const start_idx) -> int64_t {
+    int64_t neg = 1;
+    for (size_t idx = start_idx; idx <= (start_idx + 6); idx += 2)
+      neg *= matches[idx].str() == "-" ? -1 : 1;
+    return neg;
+  };
+
+  int64_t s_neg = neg_calculator(1);
+  int64_t e_neg = neg_calculator(9);
+
+  // Calculate the start and end time in ns precision.
+  start  = (int64_t)s_h * 60 * 60 + s_min * 60 + s_sec;
+  end    = (int64_t)e_h * 60 * 60 + e_min * 60 + e_sec;
+
+  start *= 1000000000ll * s_neg;
+  end   *= 1000000000ll * e_neg;
+
+  while (s_rest.length() < 9)
+    s_rest += "0";
+  if (s_rest.length() > 9)
+    s_rest.erase(9);
+  start += atol(s_rest.c_str());
+
+  while (e_rest.length() < 9)
+    e_rest += "0";
+  if (e_rest.length() > 9)
+    e_rest.erase(9);
+  end += atol(e_rest.c_str());
+
+  return true;
+}
+
+static bool
+parse_srt_timecode_line(std::string const &s,
+                        int64_t &start,
+                        int64_t &end) {
+  if (hack_engaged(ENGAGE_REGEX_TEXT_SUBTITLE_PARSERS))
+    return parse_srt_timecode_line_with_regex(s, start, end);
+  return mtx::text_subtitles::parse_srt_timecode_line(s, start, end);
+}
+
+static bool
+has_srt_coordinates(std::string const &s) {
+  if (!hack_engaged(ENGAGE_REGEX_TEXT_SUBTITLE_PARSERS))
+    return mtx::text_subtitles::has_srt_coordinates(s);
+
+  static boost::regex s_coordinates_re(SRT_RE_COORDINATES, boost::regex::perl);
+  return boost::regex_search(s, s_coordinates_re);
+}
+
+static bool
+is_srt_number(std::string const &s) {
+  if (!hack_engaged(ENGAGE_REGEX_TEXT_SUBTITLE_PARSERS))
+    return mtx::text_subtitles::is_srt_number(s);
+
+  static boost::regex s_number_re("^\\d+$", boost::regex::perl);
+  return boost::regex_match(s, s_number_re);
+}
+
 bool
 srt_parser_c::probe(mm_text_io_c *io) {
   try {
@@ -59,9 +148,8 @@ srt_parser_c::probe(mm_text_io_c *io) {
       return false;
 
     s = io->getline();
-    boost::regex timecode_re(SRT_RE_TIMECODE_LINE, boost::regex::perl);
-    boost::smatch matches;
-    if (!boost::regex_search(s, timecode_re))
+    int64_t start, end;
+    if (!parse_srt_timecode_line(s, start, end))
       return false;
 
     s = io->getline();
@@ -86,10 +174,6 @@ srt_parser_c::srt_parser_c(mm_text_io_c *io,
 
 void
 srt_parser_c::parse() {
-  boost::regex timecode_re(SRT_RE_TIMECODE_LINE, boost::regex::perl);
-  boost::regex number_re("^\\d+$", boost::regex::perl);
-  boost::regex coordinates_re(SRT_RE_COORDINATES, boost::regex::perl);
-
   int64_t start                 = 0;
   int64_t end                   = 0;
   int64_t previous_start        = 0;
@@ -123,7 +207,7 @@ srt_parser_c::parse() {
     }
 
     if (STATE_INITIAL == state) {
-      if (!boost::regex_match(s, number_re)) {
+      if (!is_srt_number(s)) {
         mxwarn_tid(m_file_name, m_tid, boost::format(Y("Error in line %1%: expected subtitle number and found some text.\n")) % line_number);
         break;
       }
@@ -131,38 +215,13 @@ srt_parser_c::parse() {
       parse_number(s, subtitle_number);
 
     } else if (STATE_TIME == state) {
-      boost::smatch matches;
-      if (!boost::regex_search(s, matches, timecode_re)) {
+      int64_t new_start = 0, new_end = 0;
+      if (!parse_srt_timecode_line(s, new_start, new_end)) {
         mxwarn_tid(m_file_name, m_tid, boost::format(Y("Error in line %1%: expected a SRT timecode line but found something else. Aborting this file.\n")) % line_number);
         break;
       }
 
-      int s_h = 0, s_min = 0, s_sec = 0, e_h = 0, e_min = 0, e_sec = 0;
-
-      //        1         2       3      4        5     6             7    8
-      // "\\s*(-?)\\s*(\\d+):\\s(-?)*(\\d+):\\s*(-?)(\\d+)[,\\.]\\s*(-?)(\\d+)?"
-
-      parse_number(matches[ 2].str(), s_h);
-      parse_number(matches[ 4].str(), s_min);
-      parse_number(matches[ 6].str(), s_sec);
-      parse_number(matches[10].str(), e_h);
-      parse_number(matches[12].str(), e_min);
-      parse_number(matches[14].str(), e_sec);
-
-      std::string s_rest = matches[ 8].str();
-      std::string e_rest = matches[16].str();
-
-      auto neg_calculator = [&](size_t const start_idx) -> int64_t {
-        int64_t neg = 1;
-        for (size_t idx = start_idx; idx <= (start_idx + 6); idx += 2)
-          neg *= matches[idx].str() == "-" ? -1 : 1;
-        return neg;
-      };
-
-      int64_t s_neg = neg_calculator(1);
-      int64_t e_neg = neg_calculator(9);
-
-      if (boost::regex_search(s, coordinates_re) && !m_coordinates_warning_shown) {
+      if (!m_coordinates_warning_shown && has_srt_coordinates(s)) {
         mxwarn_tid(m_file_name, m_tid,
                    Y("This file contains coordinates in the timecode lines. "
                      "Such coordinates are not supported by the Matroska SRT subtitle format. "
@@ -176,24 +235,9 @@ srt_parser_c::parse() {
         add(start, end, timecode_number, subtitles.c_str());
       }
 
-      // Calculate the start and end time in ns precision for the following entry.
-      start  = (int64_t)s_h * 60 * 60 + s_min * 60 + s_sec;
-      end    = (int64_t)e_h * 60 * 60 + e_min * 60 + e_sec;
-
-      start *= 1000000000ll * s_neg;
-      end   *= 1000000000ll * e_neg;
-
-      while (s_rest.length() < 9)
-        s_rest += "0";
-      if (s_rest.length() > 9)
-        s_rest.erase(9);
-      start += atol(s_rest.c_str());
-
-      while (e_rest.length() < 9)
-        e_rest += "0";
-      if (e_rest.length() > 9)
-        e_rest.erase(9);
-      end += atol(e_rest.c_str());
+      // The start and end time in ns precision for the following entry.
+      start = new_start;
+      end   = new_end;
 
       if (0 > start) {
         mxwarn_tid(m_file_name, m_tid,
@@ -224,7 +268,7 @@ srt_parser_c::parse() {
         subtitles += "\n";
       subtitles += s;
 
-    } else if (boost::regex_match(s, number_re)) {
+    } else if (is_srt_number(s)) {
       state = STATE_TIME;
       parse_number(s, subtitle_number);
 
@@ -251,6 +295,8 @@ ssa_parser_c::probe(mm_text_io_c *io) {
   boost::regex styles_re(     "^\\s*\\[V4\\+?\\s+Styles\\]", boost::regex::perl | boost::regex::icase);
   boost::regex comment_re(    "^\\s*$|^\\s*[!;]",            boost::regex::perl | boost::regex::icase);
 
+  auto use_regex = hack_engaged(ENGAGE_REGEX_TEXT_SUBTITLE_PARSERS);
+
   try {
     int line_number = 0;
     io->setFilePointer(0, seek_beginning);
@@ -264,15 +310,17 @@ ssa_parser_c::probe(mm_text_io_c *io) {
         return false;
 
       // Skip comments and empty lines.
-      if (boost::regex_search(line, comment_re))
+      if (use_regex ? boost::regex_search(line, comment_re) : mtx::text_subtitles::is_ssa_comment_or_empty(line))
         continue;
 
-      // This is the line mkvmerge is looking for: positive match.
-      if (boost::regex_search(line, script_info_re) || boost::regex_search(line, styles_re))
-        return true;
+      // The first other line decides: it must be one of the wanted
+      // section headers.
+      if (use_regex)
+        return boost::regex_search(line, script_info_re) || boost::regex_search(line, styles_re);
 
-      // Neither a wanted line nor an empty one/a comment: negative result.
-      return false;
+      return mtx::text_subtitles::is_ssa_section(line, "script info")
+          || mtx::text_subtitles::is_ssa_section(line, "v4+ styles")
+          || mtx::text_subtitles::is_ssa_section(line, "v4 styles");
     }
   } catch (...) {
   }
@@ -303,6 +351,11 @@ ssa_parser_c::parse() {
   boost::regex sec_graphics_re(  "^\\s*\\[Graphics\\]",        boost::regex::perl | boost::regex::icase);
   boost::regex sec_fonts_re(     "^\\s*\\[Fonts\\]",           boost::regex::perl | boost::regex::icase);
 
+  auto use_regex  = hack_engaged(ENGAGE_REGEX_TEXT_SUBTITLE_PARSERS);
+  auto is_section = [use_regex](std::string const &line, boost::regex const &re, char const *name) {
+    return use_regex ? boost::regex_search(line, re) : mtx::text_subtitles::is_ssa_section(line, name);
+  };
+
   int num                        = 0;
   ssa_section_e section          = SSA_SECTION_NONE;
   ssa_section_e previous_section = SSA_SECTION_NONE;
@@ -323,24 +376,24 @@ ssa_parser_c::parse() {
     if (!strcasecmp(line.c_str(), "ScriptType: v4.00+"))
       m_is_ass = true;
 
-    else if (boost::regex_search(line, sec_styles_ass_re)) {
+    else if (is_section(line, sec_styles_ass_re, "v4+ styles")) {
       m_is_ass = true;
       section  = SSA_SECTION_V4STYLES;
 
-    } else if (boost::regex_search(line, sec_styles_re))
+    } else if (is_section(line, sec_styles_re, "v4 styles"))
       section = SSA_SECTION_V4STYLES;
 
-    else if (boost::regex_search(line, sec_info_re))
+    else if (is_section(line, sec_info_re, "script info"))
       section = SSA_SECTION_INFO;
 
-    else if (boost::regex_search(line, sec_events_re))
+    else if (is_section(line, sec_events_re, "events"))
       section = SSA_SECTION_EVENTS;
 
-    else if (boost::regex_search(line, sec_graphics_re)) {
+    else if (is_section(line, sec_graphics_re, "graphics")) {
       section       = SSA_SECTION_GRAPHICS;
       add_to_global = false;
 
-    } else if (boost::regex_search(line, sec_fonts_re)) {
+    } else if (is_section(line, sec_fonts_re, "fonts")) {
       section       = SSA_SECTION_FONTS;
       add_to_global = false;
 
@@ -362,20 +415,23 @@ ssa_parser_c::parse() {
         if (m_format.empty())
           throw mtx::input::extended_x(Y("ssa_reader: Invalid format. Could not find the \"Format\" line in the \"[Events]\" section."));
 
-        std::string orig_line = line;
+        // Split the line into fields. The line itself is left alone
+        // for the warnings below.
+        auto &fields = m_fields;
 
-        line.erase(0, strlen("Dialogue: ")); // Trim the start.
+        if (use_regex) {
+          fields = split(line.substr(strlen("Dialogue: ")), ",", m_format.size());
+          while (fields.size() < m_format.size())
+            fields.push_back(std::string(""));
 
-        // Split the line into fields.
-        std::vector<std::string> fields = split(line.c_str(), ",", m_format.size());
-        while (fields.size() < m_format.size())
-          fields.push_back(std::string(""));
+        } else
+          mtx::text_subtitles::split_ssa_fields(line, strlen("Dialogue: "), m_format.size(), fields);
 
         // Parse the start time.
         std::string stime = get_element("Start", fields);
         int64_t start     = parse_time(stime);
         if (0 > start) {
-          mxwarn_tid(m_file_name, m_tid, boost::format(Y("Malformed line? (%1%)\n")) % orig_line);
+          mxwarn_tid(m_file_name, m_tid, boost::format(Y("Malformed line? (%1%)\n")) % line);
           continue;
         }
 
@@ -383,12 +439,12 @@ ssa_parser_c::parse() {
         stime       = get_element("End", fields);
         int64_t end = parse_time(stime);
         if (0 > end) {
-          mxwarn_tid(m_file_name, m_tid, boost::format(Y("Malformed line? (%1%)\n")) % orig_line);
+          mxwarn_tid(m_file_name, m_tid, boost::format(Y("Malformed line? (%1%)\n")) % line);
           continue;
         }
 
         if (end < start) {
-          mxwarn_tid(m_file_name, m_tid, boost::format(Y("Malformed line? (%1%)\n")) % orig_line);
+          mxwarn_tid(m_file_name, m_tid, boost::format(Y("Malformed line? (%1%)\n")) % line);
           continue;
         }
 
@@ -396,19 +452,27 @@ ssa_parser_c::parse() {
         // ReadOrder, Layer, Style, Name, MarginL, MarginR, MarginV, Effect,
         //   Text
 
-        std::string comma = ",";
-        line
-          = to_string(num)                          + comma
-          + get_element("Layer", fields)            + comma
-          + get_element("Style", fields)            + comma
-          + get_element(name_field.c_str(), fields) + comma
-          + get_element("MarginL", fields)          + comma
-          + get_element("MarginR", fields)          + comma
-          + get_element("MarginV", fields)          + comma
-          + get_element("Effect", fields)           + comma
-          + recode_text(fields);
-
-        add(start, end, num, line);
+        auto &entry = m_entry;
+
+        entry  = to_string(num);
+        entry += ',';
+        entry += get_element("Layer", fields);
+        entry += ',';
+        entry += get_element("Style", fields);
+        entry += ',';
+        entry += get_element(name_field.c_str(), fields);
+        entry += ',';
+        entry += get_element("MarginL", fields);
+        entry += ',';
+        entry += get_element("MarginR", fields);
+        entry += ',';
+        entry += get_element("MarginV", fields);
+        entry += ',';
+        entry += get_element("Effect", fields);
+        entry += ',';
+        entry += recode_text(fields);
+
+        add(start, end, num, entry);
         num++;
 
         add_to_global = false;
@@ -444,7 +508,7 @@ ssa_parser_c::parse() {
   sort();
 }
 
-std::string
+std::string const &
 ssa_parser_c::get_element(const char *index,
                           std::vector<std::string> &fields) {
   size_t i;
@@ -453,7 +517,7 @@ ssa_parser_c::get_element(const char *index,
     if (m_format[i] == index)
       return fields[i];
 
-  return std::string("");
+  return empty_string;
 }
 
 int64_t
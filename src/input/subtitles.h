@@ -106,7 +106,8 @@ protected:
   const std::string &m_file_name;
   int64_t m_tid;
   charset_converter_cptr m_cc_utf8;
-  std::vector<std::string> m_format;
+  std::vector<std::string> m_format, m_fields;
+  std::string m_entry;
   bool m_is_ass;
   std::string m_global;
   int64_t m_attachment_id;
@@ -139,7 +140,7 @@ public:
 
 protected:
   int64_t parse_time(std::string &time);
-  std::string get_element(const char *index, std::vector<std::string> &fields);
+  std::string const &get_element(const char *index, std::vector<std::string> &fields);
   std::string recode_text(std::vector<std::string> &fields);
   void add_attachment_maybe(std::string &name, std::string &data_uu, ssa_section_e section);
   void decode_chars(unsigned char const *in, unsigned char *out, size_t bytes_in);
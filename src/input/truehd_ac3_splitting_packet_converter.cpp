@@ -28,7 +28,7 @@ truehd_ac3_splitting_packet_converter_c::truehd_ac3_splitting_packet_converter_c
 
 bool
 truehd_ac3_splitting_packet_converter_c::convert(packet_cptr const &packet) {
-  m_parser.add_data(packet->data->get_buffer(), packet->data->get_size());
+  m_parser.add_bytes(packet->data);
   m_parser.parse(true);
 
   m_truehd_timecode = packet->timecode;
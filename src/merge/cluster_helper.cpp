@@ -389,9 +389,43 @@ cluster_helper_c::must_duration_be_set(render_groups_c *rg,
             question doesn't it"
 */
 
+render_groups_c *
+cluster_helper_c::get_render_group(generic_packetizer_c *source) {
+  auto slot_idx = static_cast<size_t>(std::max(source->get_track_num(), 0));
+
+  if (m->render_group_slots.size() <= slot_idx)
+    m->render_group_slots.resize(slot_idx + 1);
+
+  auto &slot                    = m->render_group_slots[slot_idx];
+  render_groups_c *render_group = nullptr;
+
+  for (auto &rg : slot)
+    if (rg->m_source == source) {
+      render_group = rg.get();
+      break;
+    }
+
+  if (!render_group) {
+    slot.push_back(std::make_shared<render_groups_c>(source));
+    render_group = slot.back().get();
+  }
+
+  if (render_group->m_groups.empty())
+    m->active_render_groups.push_back(render_group);
+
+  return render_group;
+}
+
+void
+cluster_helper_c::reset_render_groups() {
+  for (auto rg : m->active_render_groups)
+    rg->reset();
+
+  m->active_render_groups.clear();
+}
+
 int
 cluster_helper_c::render() {
-  std::vector<render_groups_cptr> render_groups;
   KaxCues cues;
   cues.SetGlobalTimecodeScale(g_timecode_scale);
 
@@ -431,17 +465,7 @@ cluster_helper_c::render() {
     if (source->contains_gap())
       m->cluster->SetSilentTrackUsed();
 
-    render_groups_c *render_group = nullptr;
-    for (auto &rg : render_groups)
-      if (rg->m_source == source) {
-        render_group = rg.get();
-        break;
-      }
-
-    if (!render_group) {
-      render_groups.push_back(render_groups_cptr(new render_groups_c(source)));
-      render_group = render_groups.back().get();
-    }
+    auto render_group                      = get_render_group(source);
 
     min_cl_timecode                        = std::min(pack->assigned_timecode, min_cl_timecode);
     max_cl_timecode                        = std::max(pack->assigned_timecode, max_cl_timecode);
@@ -550,8 +574,8 @@ cluster_helper_c::render() {
 
   if (!discarding()) {
     if (0 < elements_in_cluster) {
-      for (auto &rg : render_groups)
-        set_duration(rg.get());
+      for (auto rg : m->active_render_groups)
+        set_duration(rg);
 
       m->cluster->SetPreviousTimecode(min_cl_timecode - timecode_offset - 1, (int64_t)g_timecode_scale);
       m->cluster->set_min_timecode(min_cl_timecode - timecode_offset);
@@ -576,6 +600,8 @@ cluster_helper_c::render() {
 
   m->cluster->delete_non_blocks();
 
+  reset_render_groups();
+
   return 1;
 }
 
@@ -710,9 +736,12 @@ cluster_helper_c::create_tags_for_track_statistics(KaxTags &tags,
     auto track_uid    = ptzr.packetizer->get_uid();
     auto const &stats = m->track_statistics[track_uid];
     auto bps          = stats.get_bits_per_second();
+    auto peak_bps     = stats.get_peak_bits_per_second();
     auto duration     = stats.get_duration();
 
     mtx::tags::remove_simple_tags_for<KaxTagTrackUID>(tags, track_uid, "BPS");
+    if (g_peak_bitrate_statistics_tag)
+      mtx::tags::remove_simple_tags_for<KaxTagTrackUID>(tags, track_uid, "PEAK_BPS");
     mtx::tags::remove_simple_tags_for<KaxTagTrackUID>(tags, track_uid, "DURATION");
     mtx::tags::remove_simple_tags_for<KaxTagTrackUID>(tags, track_uid, "NUMBER_OF_FRAMES");
     mtx::tags::remove_simple_tags_for<KaxTagTrackUID>(tags, track_uid, "NUMBER_OF_BYTES");
@@ -722,13 +751,15 @@ cluster_helper_c::create_tags_for_track_statistics(KaxTags &tags,
     mtx::tags::set_target_type(*tag, mtx::tags::Movie, "MOVIE");
 
     mtx::tags::set_simple(*tag, "BPS",              to_string(bps ? *bps : 0));
+    if (g_peak_bitrate_statistics_tag)
+      mtx::tags::set_simple(*tag, "PEAK_BPS",       to_string(peak_bps ? *peak_bps : 0));
     mtx::tags::set_simple(*tag, "DURATION",         format_timecode(duration ? *duration : 0));
     mtx::tags::set_simple(*tag, "NUMBER_OF_FRAMES", to_string(stats.get_num_frames()));
     mtx::tags::set_simple(*tag, "NUMBER_OF_BYTES",  to_string(stats.get_num_bytes()));
 
     mtx::tags::set_simple(*tag, "_STATISTICS_WRITING_APP",      writing_app);
     mtx::tags::set_simple(*tag, "_STATISTICS_WRITING_DATE_UTC", writing_date_str);
-    mtx::tags::set_simple(*tag, "_STATISTICS_TAGS",             "BPS DURATION NUMBER_OF_FRAMES NUMBER_OF_BYTES");
+    mtx::tags::set_simple(*tag, "_STATISTICS_TAGS",             g_peak_bitrate_statistics_tag ? "BPS PEAK_BPS DURATION NUMBER_OF_FRAMES NUMBER_OF_BYTES" : "BPS DURATION NUMBER_OF_FRAMES NUMBER_OF_BYTES");
   }
 
   m->track_statistics.clear();
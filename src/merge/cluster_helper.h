@@ -27,6 +27,7 @@
 
 #define RND_TIMECODE_SCALE(a) (std::llround(static_cast<double>(a) / static_cast<double>(g_timecode_scale)) * static_cast<int64_t>(g_timecode_scale))
 
+class generic_packetizer_c;
 class render_groups_c;
 class packet_t;
 using packet_cptr = std::shared_ptr<packet_t>;
@@ -70,6 +71,9 @@ public:
   void create_tags_for_track_statistics(KaxTags &tags, std::string const &writing_app, boost::posix_time::ptime const &writing_date);
 
 private:
+  render_groups_c *get_render_group(generic_packetizer_c *source);
+  void reset_render_groups();
+
   void set_duration(render_groups_c *rg);
   bool must_duration_be_set(render_groups_c *rg, packet_cptr &new_packet);
 
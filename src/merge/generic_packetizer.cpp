@@ -25,6 +25,7 @@
 #include <matroska/KaxTrackVideo.h>
 
 #include "common/compression.h"
+#include "common/compression/zlib.h"
 #include "common/container.h"
 #include "common/ebml.h"
 #include "common/hacks.h"
@@ -84,6 +85,7 @@ generic_packetizer_c::generic_packetizer_c(generic_reader_c *reader,
   , m_hvideo_display_width{-1}
   , m_hvideo_display_height{-1}
   , m_hcompression{COMPRESSION_UNSPECIFIED}
+  , m_hcompression_level{-1}
   , m_timecode_factory_application_mode{TFA_AUTOMATIC}
   , m_last_cue_timecode{-1}
   , m_has_been_flushed{}
@@ -166,6 +168,11 @@ generic_packetizer_c::generic_packetizer_c(generic_reader_c *reader,
   else if (mtx::includes(m_ti.m_compression_list, -1))
     m_ti.m_compression = m_ti.m_compression_list[-1];
 
+  if (mtx::includes(m_ti.m_compression_level_list, m_ti.m_id))
+    m_ti.m_compression_level = m_ti.m_compression_level_list[m_ti.m_id];
+  else if (mtx::includes(m_ti.m_compression_level_list, -1))
+    m_ti.m_compression_level = m_ti.m_compression_level_list[-1];
+
   // Let's see if the user has specified a name for this track.
   if (mtx::includes(m_ti.m_track_names, m_ti.m_id))
     m_ti.m_track_name = m_ti.m_track_names[m_ti.m_id];
@@ -235,8 +242,10 @@ generic_packetizer_c::generic_packetizer_c(generic_reader_c *reader,
     m_ti.m_nalu_size_length = m_ti.m_nalu_size_lengths[-1];
 
   // Let's see if the user has specified a compression scheme for this track.
-  if (COMPRESSION_UNSPECIFIED != m_ti.m_compression)
-    m_hcompression = m_ti.m_compression;
+  if (COMPRESSION_UNSPECIFIED != m_ti.m_compression) {
+    m_hcompression       = m_ti.m_compression;
+    m_hcompression_level = m_ti.m_compression_level;
+  }
 
   // Set default header values to 'unset'.
   if (!m_reader->m_appending) {
@@ -760,7 +769,7 @@ generic_packetizer_c::set_headers() {
     GetChild<KaxContentEncodingType >(c_encoding).SetValue(0); // It's a compression.
     GetChild<KaxContentEncodingScope>(c_encoding).SetValue(1); // Only the frame contents have been compresed.
 
-    m_compressor = compressor_c::create(m_hcompression);
+    create_compressor();
     m_compressor->set_track_headers(c_encoding);
   }
 
@@ -777,6 +786,15 @@ generic_packetizer_c::set_headers() {
   }
 }
 
+void
+generic_packetizer_c::create_compressor() {
+  m_compressor = compressor_c::create(m_hcompression);
+
+  auto zlib_compressor = std::dynamic_pointer_cast<zlib_compressor_c>(m_compressor);
+  if (zlib_compressor && (-1 != m_hcompression_level))
+    zlib_compressor->set_compression_level(m_hcompression_level);
+}
+
 void
 generic_packetizer_c::fix_headers() {
   GetChild<KaxTrackFlagDefault>(m_track_entry).SetValue(g_default_tracks[TRACK_TYPE_TO_DEFTRACK_TYPE(m_htrack_type)] == m_hserialno ? 1 : 0);
@@ -1082,11 +1100,13 @@ generic_packetizer_c::connect(generic_packetizer_c *src,
   m_htrack_default_duration    = src->m_htrack_default_duration;
   m_huid                       = src->m_huid;
   m_hcompression               = src->m_hcompression;
-  m_compressor                 = compressor_c::create(m_hcompression);
+  m_hcompression_level         = src->m_hcompression_level;
   m_last_cue_timecode          = src->m_last_cue_timecode;
   m_timecode_factory           = src->m_timecode_factory;
   m_correction_timecode_offset = 0;
 
+  create_compressor();
+
   if (-1 == append_timecode_offset)
     m_append_timecode_offset   = src->m_max_timecode_seen;
   else
@@ -74,6 +74,7 @@ protected:
   int m_hvideo_interlaced_flag, m_hvideo_pixel_width, m_hvideo_pixel_height, m_hvideo_display_width, m_hvideo_display_height;
 
   compression_method_e m_hcompression;
+  int m_hcompression_level;
   compressor_ptr m_compressor;
 
   timecode_factory_cptr m_timecode_factory;
@@ -263,6 +264,8 @@ protected:
   };
 
   virtual void show_experimental_status_version(std::string const &codec_id);
+
+  void create_compressor();
 };
 
 extern std::vector<generic_packetizer_c *> ptzrs_in_header_order;
@@ -14,6 +14,13 @@
 #include "merge/id_result.h"
 #include "merge/output_control.h"
 
+/** \brief Reports a recognized but unsupported container format
+
+   When identifying, the result is output, and
+   \c mtx::input::unsupported_container_x is thrown. The caller of the
+   identification decides about the exit code; the server mode must
+   keep running. Otherwise this is an error.
+*/
 void
 id_result_container_unsupported(const std::string &filename,
                                 const std::string &info) {
@@ -22,7 +29,7 @@ id_result_container_unsupported(const std::string &filename,
       mxinfo(boost::format("File '%1%': unsupported container: %2%\n") % filename % info);
     else
       mxinfo(boost::format(Y("File '%1%': unsupported container: %2%\n")) % filename % info);
-    mxexit(3);
+    throw mtx::input::unsupported_container_x{};
 
   } else
     mxerror(boost::format(Y("The file '%1%' is a non-supported file type (%2%).\n")) % filename % info);
@@ -16,6 +16,8 @@
 
 #include "common/common_pch.h"
 
+#include "merge/input_x.h"
+
 #define ID_RESULT_TRACK_AUDIO     "audio"
 #define ID_RESULT_TRACK_VIDEO     "video"
 #define ID_RESULT_TRACK_SUBTITLES "subtitles"
@@ -46,6 +46,15 @@ namespace mtx {
       }
     };
 
+    // Thrown while identifying a file whose container format is
+    // recognized but not supported.
+    class unsupported_container_x: public exception {
+    public:
+      virtual const char *what() const throw() {
+        return "unsupported container";
+      }
+    };
+
     class extended_x: public exception {
     protected:
       std::string m_message;
@@ -55,6 +55,7 @@
 #include "common/unique_numbers.h"
 #include "common/version.h"
 #include "common/webm.h"
+#include "common/xml/ebml_chapters_converter.h"
 #include "common/xml/ebml_segmentinfo_converter.h"
 #include "common/xml/ebml_tags_converter.h"
 #include "merge/cluster_helper.h"
@@ -62,6 +63,7 @@
 #include "merge/generic_reader.h"
 #include "merge/output_control.h"
 #include "merge/reader_detection_and_creation.h"
+#include "merge/server_mode.h"
 #include "merge/track_info.h"
 
 using namespace libmatroska;
@@ -114,6 +116,9 @@ set_usage() {
   usage_text += Y("  --timecode-scale <n>     Force the timecode scale factor to n.\n");
   usage_text += Y("  --disable-track-statistics-tags\n"
                   "                           Do not write tags with track statistics.\n");
+  usage_text += Y("  --enable-peak-bitrate-tag\n"
+                  "                           Add the peak bitrate to the track statistics\n"
+                  "                           tags.\n");
   usage_text +=   "\n";
   usage_text += Y(" File splitting, linking, appending and concatenating (more global options):\n");
   usage_text += Y("  --split <d[K,M,G]|HH:MM:SS|s>\n"
@@ -259,12 +264,15 @@ set_usage() {
                   "                           read as for the conversion to UTF-8.\n");
   usage_text +=   "\n";
   usage_text += Y(" Options that only apply to VobSub subtitle tracks:\n");
-  usage_text += Y("  --compression <TID:method>\n"
+  usage_text += Y("  --compression <TID:method[:level]>\n"
                   "                           Sets the compression method used for the\n"
-                  "                           specified track ('none' or 'zlib').\n");
+                  "                           specified track ('none' or 'zlib'). For\n"
+                  "                           'zlib' a level between 0 and 9 can be given.\n");
   usage_text +=   "\n\n";
   usage_text += Y(" Other options:\n");
   usage_text += Y("  -i, --identify <file>    Print information about the source file.\n");
+  usage_text += Y("  --server                 Identify files named in JSON requests read from\n"
+                  "                           stdin, writing one JSON response per request.\n");
   usage_text += Y("  -l, --list-types         Lists supported input file types.\n");
   usage_text += Y("  --list-languages         Lists all ISO639 languages and their\n"
                   "                           ISO639-2 codes.\n");
@@ -276,6 +284,11 @@ set_usage() {
   usage_text += Y("  --output-charset <cset>  Output messages in this charset\n");
   usage_text += Y("  -r, --redirect-output <file>\n"
                   "                           Redirects all messages into this file.\n");
+  usage_text += Y("  --drop-input-from-cache  Read the source files sequentially and drop data\n"
+                  "                           that has been read from the operating system's\n"
+                  "                           file cache.\n");
+  usage_text += Y("  --drop-output-from-cache Drop written data from the operating system's\n"
+                  "                           file cache and reserve disk space up front.\n");
   usage_text += Y("  --debug <topic>          Turns on debugging output for 'topic'.\n");
   usage_text += Y("  --engage <feature>       Turns on experimental feature 'feature'.\n");
   usage_text += Y("  @optionsfile             Reads additional command line options from\n"
@@ -474,6 +487,12 @@ parse_number_with_unit(const std::string &s,
     return (int64_t)(multiplier * d_value);
 }
 
+static std::vector<std::string> s_global_tags_file_names;
+// The chapter language and character set apply to the chapter file
+// given after them. They are reset for each source file, so they must
+// be remembered until the chapter file is parsed.
+static std::string s_chapter_file_language, s_chapter_file_charset;
+
 /** \brief Parse tags and add them to the list of all tags
 
    Also tests the tags for missing mandatory elements.
@@ -1070,6 +1089,8 @@ parse_arg_cues(const std::string &s,
 /** \brief Parse the \c --compression argument
 
    The argument must have the form \c TID:compression, e.g. \c 0:zlib.
+   For zlib an optional compression level between 0 and 9 can be
+   appended, e.g. \c 0:zlib:6.
 */
 static void
 parse_arg_compression(const std::string &s,
@@ -1094,8 +1115,19 @@ parse_arg_compression(const std::string &s,
   available_compression_methods.push_back("analyze_header_removal");
 
   ti.m_compression_list[id] = COMPRESSION_UNSPECIFIED;
+  ti.m_compression_level_list.erase(id);
   balg::to_lower(parts[1]);
 
+  std::vector<std::string> method_and_level = split(parts[1], ":", 2);
+  if (method_and_level.size() == 2) {
+    int level = 0;
+    if ((method_and_level[0] != "zlib") || !parse_number(method_and_level[1], level) || (0 > level) || (9 < level))
+      mxerror(boost::format(Y("Invalid compression level in '--compression %1%'. A level between 0 and 9 can only be given for 'zlib'.\n")) % s);
+
+    ti.m_compression_level_list[id] = level;
+    parts[1]                        = method_and_level[0];
+  }
+
   if (parts[1] == "zlib")
     ti.m_compression_list[id] = COMPRESSION_ZLIB;
 
@@ -1199,6 +1231,8 @@ parse_arg_tags(const std::string &s,
     mxerror(boost::format(Y("Invalid tags file name specified in '%1% %2%'.\n")) % opt % s);
 
   ti.m_all_tags[id] = parts[1];
+
+  mtx::xml::preload_file(parts[1]);
 }
 
 /** \brief Parse the \c --fourcc argument
@@ -1578,8 +1612,12 @@ parse_arg_chapters(const std::string &param,
   if (g_chapter_file_name != "")
     mxerror(boost::format(Y("Only one chapter file allowed in '%1% %2%'.\n")) % param % arg);
 
-  g_chapter_file_name = arg;
-  g_kax_chapters      = parse_chapters(g_chapter_file_name, 0, -1, 0, g_chapter_language.c_str(), g_chapter_charset.c_str(), false, nullptr, &g_tags_from_cue_chapters);
+  g_chapter_file_name     = arg;
+  s_chapter_file_language = g_chapter_language;
+  s_chapter_file_charset  = g_chapter_charset;
+
+  if (mtx::xml::ebml_chapters_converter_c::probe_file(arg))
+    mtx::xml::preload_file(arg);
 }
 
 static void
@@ -1780,6 +1818,13 @@ parse_common_args(std::vector<std::string> args) {
 
 static void
 parse_args(std::vector<std::string> args) {
+  // Server mode: identify files requested on stdin until stdin is
+  // closed. No other options are allowed.
+  if ((1 == args.size()) && (args[0] == "--server")) {
+    run_server_mode(identify);
+    mxexit();
+  }
+
   // Check if only information about the file is wanted. In this mode only
   // two parameters are allowed: the --identify switch and the file.
   if ((   (2 == args.size())
@@ -1800,7 +1845,12 @@ parse_args(std::vector<std::string> args) {
     if (3 == args.size())
       verbose = 3;
 
-    identify(args[1]);
+    try {
+      identify(args[1]);
+    } catch (mtx::input::unsupported_container_x &) {
+      mxexit(3);
+    }
+
     mxexit();
   }
 
@@ -1818,7 +1868,10 @@ parse_args(std::vector<std::string> args) {
       list_iso639_languages();
       mxexit();
 
-    } else if ((this_arg == "-i") || (this_arg == "--identify") || (this_arg == "-I") || (this_arg == "--identify-verbose") || (this_arg == "--identify-for-mmg"))
+    } else if (this_arg == "--server")
+      mxerror(Y("'--server' cannot be combined with other options.\n"));
+
+    else if ((this_arg == "-i") || (this_arg == "--identify") || (this_arg == "-I") || (this_arg == "--identify-verbose") || (this_arg == "--identify-for-mmg"))
       mxerror(boost::format(Y("'%1%' can only be used with a file name. No further options are allowed if this option is used.\n")) % this_arg);
 
     else if (this_arg == "--capabilities") {
@@ -1970,6 +2023,9 @@ parse_args(std::vector<std::string> args) {
     else if (this_arg == "--disable-track-statistics-tags")
       g_no_track_statistics_tags = true;
 
+    else if (this_arg == "--enable-peak-bitrate-tag")
+      g_peak_bitrate_statistics_tag = true;
+
     else if (this_arg == "--attachment-description") {
       if (no_next_arg)
         mxerror(Y("'--attachment-description' lacks the description.\n"));
@@ -2012,7 +2068,8 @@ parse_args(std::vector<std::string> args) {
       if (no_next_arg)
         mxerror(Y("'--global-tags' lacks the file name.\n"));
 
-      parse_and_add_tags(next_arg);
+      s_global_tags_file_names.push_back(next_arg);
+      mtx::xml::preload_file(next_arg);
       sit++;
 
       inputs_found = true;
@@ -2498,6 +2555,21 @@ setup(int argc,
   return args;
 }
 
+/** \brief Parse the global tag and chapter files
+
+   This is done after the readers have been created. The XML files
+   have already been loaded in the background while the source files
+   were being probed.
+*/
+static void
+parse_global_tags_and_chapters() {
+  for (auto const &file_name : s_global_tags_file_names)
+    parse_and_add_tags(file_name);
+
+  if (!g_chapter_file_name.empty())
+    g_kax_chapters = parse_chapters(g_chapter_file_name, 0, -1, 0, s_chapter_file_language.c_str(), s_chapter_file_charset.c_str(), false, nullptr, &g_tags_from_cue_chapters);
+}
+
 /** \brief Setup and high level program control
 
    Calls the functions for setup, handling the command line arguments,
@@ -2517,6 +2589,7 @@ main(int argc,
   create_readers();
 
   if (!g_identifying) {
+    parse_global_tags_and_chapters();
     create_packetizers();
     if (g_packetizers.empty() && !g_files.empty())
       mxerror(Y("No streams to output were found. Aborting.\n"));
@@ -2545,7 +2618,15 @@ main(int argc,
             % ex.what() % ex.error());
   }
 
-  mxinfo(boost::format(Y("Muxing took %1%.\n")) % create_minutes_seconds_time_string((mtx::sys::get_current_time_millis() - start + 500) / 1000, true));
+  auto duration = mtx::sys::get_current_time_millis() - start;
+
+  mxinfo(boost::format(Y("Muxing took %1%.\n")) % create_minutes_seconds_time_string((duration + 500) / 1000, true));
+
+  if (2 <= verbose) {
+    int64_t num_bytes_read = mm_file_io_c::ms_num_bytes_read;
+    mxinfo(boost::format(Y("%1% were read from the source files, %2% per second.\n"))
+           % format_file_size(num_bytes_read) % format_file_size(num_bytes_read * 1000 / std::max<int64_t>(duration, 1)));
+  }
 
   cleanup();
 
@@ -17,6 +17,7 @@
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <cmath>
+#include <future>
 #include <iostream>
 #include <typeinfo>
 
@@ -105,6 +106,7 @@ bool g_no_lacing                            = false;
 bool g_no_linking                           = true;
 bool g_use_durations                        = false;
 bool g_no_track_statistics_tags             = false;
+bool g_peak_bitrate_statistics_tag          = false;
 
 double g_timecode_scale                     = TIMECODE_SCALE;
 timecode_scale_mode_e g_timecode_scale_mode = TIMECODE_SCALE_MODE_NORMAL;
@@ -169,6 +171,7 @@ static int64_t s_max_chapter_size           = 0;
 static std::unique_ptr<EbmlVoid> s_void_after_track_headers;
 
 static mm_io_cptr s_out;
+static std::future<void> s_output_closer;
 
 static bitvalue_c s_seguid_prev(128), s_seguid_current(128), s_seguid_next(128);
 
@@ -1264,6 +1267,16 @@ create_next_output_file() {
     mxerror(boost::format(Y("The file '%1%' could not be opened for writing: %2%.\n")) % this_outfile % ex);
   }
 
+  // When the output isn't split the output file will be roughly as
+  // big as all input files combined. Reserve that much space up front.
+  if (mm_file_io_c::ms_drop_output_from_cache && !g_cluster_helper->splitting() && !g_cluster_helper->discarding()) {
+    auto estimated_size = int64_t{};
+    for (auto &file : g_files)
+      estimated_size += file->size;
+
+    s_out->preallocate(estimated_size);
+  }
+
   if (verbose && !g_cluster_helper->discarding())
     mxinfo(boost::format(Y("The file '%1%' has been opened for writing.\n")) % this_outfile);
 
@@ -1350,6 +1363,47 @@ set_track_statistics_tags(KaxTags *tags) {
   return tags;
 }
 
+static void
+wait_for_output_closer() {
+  if (!s_output_closer.valid())
+    return;
+
+  try {
+    s_output_closer.get();
+
+  } catch (...) {
+    output_deferred_warnings();
+    throw;
+  }
+
+  output_deferred_warnings();
+}
+
+/* When splitting into many files the final flush of the write buffer
+   and closing a finished file are done in the background while muxing
+   continues with the next file. Everything else finish_file() does
+   still happens on the main thread. At most one file is being closed
+   at any time. Errors are re-thrown and warnings are output on the
+   main thread the next time the closer is waited for. */
+static void
+close_output_file(bool in_background) {
+  wait_for_output_closer();
+
+  if (!in_background) {
+    s_out.reset();
+    return;
+  }
+
+  auto out = s_out;
+  s_out.reset();
+
+  s_output_closer = std::async(std::launch::async, [out]() mutable {
+    defer_warnings_of_this_thread();
+    out->close();
+    out.reset();
+  });
+}
+
 /** \brief Finishes and closes the current file
 
    Renders the data that is generated during the muxing run. The cues
@@ -1504,7 +1558,7 @@ finish_file(bool last_file,
   if (g_kax_segment->ForceSize(final_file_size - g_kax_segment->GetElementPosition() - g_kax_segment->HeadSize()))
     g_kax_segment->OverwriteHead(*s_out);
 
-  s_out.reset();
+  close_output_file(!last_file && g_cluster_helper->split_mode_produces_many_files());
 
   // The tracks element must not be deleted.
   size_t i;
@@ -1523,6 +1577,14 @@ finish_file(bool last_file,
 
 void
 force_close_output_file() {
+  // This is called while handling another error already. Write errors
+  // of the previous file can only be reported, not thrown.
+  try {
+    wait_for_output_closer();
+  } catch (mtx::mm_io::exception &ex) {
+    mxwarn(boost::format("%1% %2% %3%; %4%\n") % Y("An exception occurred when writing the previous output file.") % Y("Exception details:") % ex.what() % ex.error());
+  }
+
   if (!s_out)
     return;
 
@@ -30,6 +30,13 @@ public:
     , m_duration_mandatory(false)
   {
   }
+
+  void reset() {
+    m_groups.clear();
+    m_durations.clear();
+    m_more_data          = false;
+    m_duration_mandatory = false;
+  }
 };
 using render_groups_cptr = std::shared_ptr<render_groups_c>;
 
@@ -56,6 +63,14 @@ public:
 
   std::unordered_map<uint64_t, track_statistics_c> track_statistics;
 
+  // Render groups are kept across clusters in slots indexed by track
+  // number. A slot only holds more than one entry if appended
+  // packetizers share a track number. Only the groups used in the
+  // current cluster are listed in active_render_groups; they're reset
+  // after the cluster's been written.
+  std::vector<std::vector<render_groups_cptr>> render_group_slots;
+  std::vector<render_groups_c *> active_render_groups;
+
 public:
   impl_t();
   ~impl_t();
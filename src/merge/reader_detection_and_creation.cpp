@@ -119,6 +119,9 @@ detect_text_file_formats(filelist_t const &file) {
     else if (microdvd_reader_c::probe_file(text_io.get(), text_size))
       return FILE_TYPE_MICRODVD;
 
+  } catch (mtx::input::unsupported_container_x &) {
+    throw;
+
   } catch (mtx::mm_io::exception &ex) {
     mxerror(boost::format(Y("The file '%1%' could not be opened for reading: %2%.\n")) % file.name % ex);
 
@@ -397,6 +400,9 @@ create_readers() {
       mxdebug_if(s_debug_timecode_restrictions,
                  boost::format("Timecode restrictions for %3%: min %1% max %2%\n") % file->restricted_timecode_min % file->restricted_timecode_max % file->ti->m_fname);
 
+    } catch (mtx::input::unsupported_container_x &) {
+      throw;
+
     } catch (mtx::mm_io::open_x &error) {
       mxerror(boost::format(Y("The demultiplexer for the file '%1%' failed to initialize:\n%2%\n")) % file->ti->m_fname % Y("The file could not be opened for reading, or there was not enough data to parse its headers."));
 
@@ -0,0 +1,390 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit http://www.gnu.org/copyleft/gpl.html
+
+   server mode: handling requests read from stdin
+
+   Written by Moritz Bunkus <moritz@bunkus.org>.
+*/
+
+#include "common/common_pch.h"
+
+#include <iostream>
+#include <utf8.h>
+
+#include "common/strings/editing.h"
+#include "merge/filelist.h"
+#include "merge/input_x.h"
+#include "merge/output_control.h"
+#include "merge/server_mode.h"
+
+/* In server mode mkvmerge reads one request per line from stdin and
+   writes exactly one response line to stdout for each of them. Both
+   are JSON objects. Requests look like this:
+
+     {"id":"1","action":"identify","file":"movie.mkv","mode":"mmg"}
+
+   "mode" is optional and can be "normal" (default), "verbose" or
+   "mmg", corresponding to --identify, --identify-verbose and
+   --identify-for-mmg. "id" is optional and copied into the response
+   verbatim. The response contains the lines normally written to
+   stdout and the warnings and errors issued while handling the
+   request:
+
+     {"id":"1","exit_code":0,"output":["File 'movie.mkv': ..."],"warnings":[],"errors":[]}
+
+   "exit_code" is the one mkvmerge would have exited with: 0 on
+   success, 2 for errors and 3 for unsupported container formats.
+   Warnings don't change it as they're suppressed during normal
+   identification.
+
+   Requests are processed sequentially. An empty line or the end of
+   stdin terminates the server. */
+
+namespace {
+
+using request_t = std::map<std::string, std::string>;
+
+class server_error_x: public mtx::exception {
+protected:
+  std::string m_message;
+
+public:
+  server_error_x(std::string const &message)  : m_message(message)       { }
+  server_error_x(boost::format const &message): m_message(message.str()) { }
+  virtual ~server_error_x() throw() { }
+
+  virtual const char *what() const throw() {
+    return m_message.c_str();
+  }
+};
+
+// Thrown by the error message handler after the message has been
+// recorded for the response.
+class error_reported_x: public mtx::exception {
+public:
+  virtual const char *what() const throw() {
+    return "error reported";
+  }
+};
+
+// A minimal parser for the requests: a single JSON object whose
+// values are strings, numbers, booleans or null. Nested objects and
+// arrays are not needed for any request and are rejected.
+class request_parser_c {
+protected:
+  std::string const &m_line;
+  size_t m_pos;
+
+public:
+  request_parser_c(std::string const &line)
+    : m_line(line)
+    , m_pos{}
+  {
+  }
+
+  request_t
+  parse() {
+    auto request = request_t{};
+
+    expect('{');
+
+    if (peek() == '}') {
+      ++m_pos;
+      expect_end();
+      return request;
+    }
+
+    while (true) {
+      auto key     = parse_string();
+      expect(':');
+      request[key] = parse_value();
+
+      auto c = next();
+      if (c == '}')
+        break;
+      if (c != ',')
+        throw server_error_x{Y("Expected ',' or '}' in the request.")};
+    }
+
+    expect_end();
+
+    return request;
+  }
+
+protected:
+  char
+  peek() {
+    while ((m_pos < m_line.length()) && isblanktab(m_line[m_pos]))
+      ++m_pos;
+
+    return m_pos < m_line.length() ? m_line[m_pos] : '\0';
+  }
+
+  char
+  next() {
+    auto c = peek();
+    if (m_pos < m_line.length())
+      ++m_pos;
+    return c;
+  }
+
+  void
+  expect(char wanted) {
+    if (next() != wanted)
+      throw server_error_x{boost::format(Y("Expected '%1%' in the request.")) % wanted};
+  }
+
+  void
+  expect_end() {
+    if (peek() != '\0')
+      throw server_error_x{Y("Unexpected data after the end of the request.")};
+  }
+
+  std::string
+  parse_value() {
+    auto c = peek();
+
+    if (c == '"')
+      return parse_string();
+
+    if ((c == '{') || (c == '['))
+      throw server_error_x{Y("Objects and arrays are not supported as values in requests.")};
+
+    auto start = m_pos;
+    while ((m_pos < m_line.length()) && (m_line[m_pos] != ',') && (m_line[m_pos] != '}') && !isblanktab(m_line[m_pos]))
+      ++m_pos;
+
+    auto value = m_line.substr(start, m_pos - start);
+    if (value.empty())
+      throw server_error_x{Y("Missing value in the request.")};
+
+    return value == "null" ? std::string{} : value;
+  }
+
+  unsigned int
+  parse_hex4() {
+    if ((m_pos + 4) > m_line.length())
+      throw server_error_x{Y("Invalid escape sequence in the request.")};
+
+    auto value = 0u;
+    for (auto idx = 0; idx < 4; ++idx) {
+      auto c  = m_line[m_pos++];
+      value <<= 4;
+      value  |= ((c >= '0') && (c <= '9')) ? c - '0'
+              : ((c >= 'a') && (c <= 'f')) ? c - 'a' + 10
+              : ((c >= 'A') && (c <= 'F')) ? c - 'A' + 10
+              : throw server_error_x{Y("Invalid escape sequence in the request.")};
+    }
+
+    return value;
+  }
+
+  std::string
+  parse_string() {
+    expect('"');
+
+    auto result = std::string{};
+
+    while (true) {
+      if (m_pos >= m_line.length())
+        throw server_error_x{Y("Unterminated string in the request.")};
+
+      auto c = m_line[m_pos++];
+      if (c == '"')
+        return result;
+
+      if (c != '\\') {
+        result += c;
+        continue;
+      }
+
+      if (m_pos >= m_line.length())
+        throw server_error_x{Y("Unterminated string in the request.")};
+
+      c = m_line[m_pos++];
+
+      if (c == 'u') {
+        auto code_point = parse_hex4();
+
+        if (   ((code_point & 0xfc00) == 0xd800)
+            && ((m_pos + 6) <= m_line.length())
+            && (m_line[m_pos] == '\\')
+            && (m_line[m_pos + 1] == 'u')) {
+          m_pos     += 2;
+          auto low   = parse_hex4();
+          code_point = 0x10000 + ((code_point & 0x3ff) << 10) + (low & 0x3ff);
+        }
+
+        utf8::append(code_point, std::back_inserter(result));
+
+      } else
+        result += c == 'b' ? '\b'
+                : c == 'f' ? '\f'
+                : c == 'n' ? '\n'
+                : c == 'r' ? '\r'
+                : c == 't' ? '\t'
+                :            c;
+    }
+  }
+};
+
+std::string
+json_string(std::string const &s) {
+  return "\"" + escape_json(s) + "\"";
+}
+
+std::string
+json_string_array(std::vector<std::string> const &strings) {
+  auto result = std::string{"["};
+
+  for (auto idx = 0u; idx < strings.size(); ++idx)
+    result += (idx ? "," : "") + json_string(strings[idx]);
+
+  return result + "]";
+}
+
+class server_c {
+protected:
+  identify_function_t const &m_identify;
+  std::string m_output;
+  std::vector<std::string> m_warnings, m_errors;
+
+public:
+  server_c(identify_function_t const &identify)
+    : m_identify(identify)
+  {
+  }
+
+  void
+  run() {
+    // Everything the readers output is collected per request instead
+    // of being written to stdout directly. Errors abort the current
+    // request only instead of exiting. They're recorded before
+    // throwing as code catching all exceptions might swallow them.
+    set_mxmsg_handler(MXMSG_INFO,    [this](unsigned int, std::string const &message) { m_output += message; });
+    set_mxmsg_handler(MXMSG_WARNING, [this](unsigned int, std::string const &message) { m_warnings.push_back(strip_copy(message, true)); });
+    set_mxmsg_handler(MXMSG_ERROR,   [this](unsigned int, std::string const &message) {
+      m_errors.push_back(strip_copy(message, true));
+      throw error_reported_x{};
+    });
+
+    std::string line;
+    while (std::getline(std::cin, line)) {
+      strip(line, true);
+      if (line.empty())
+        break;
+
+      handle_line(line);
+    }
+  }
+
+protected:
+  void
+  handle_line(std::string const &line) {
+    m_output.clear();
+    m_warnings.clear();
+    m_errors.clear();
+
+    auto id        = std::string{};
+    auto exit_code = 0;
+
+    try {
+      auto request = request_parser_c{line}.parse();
+      id           = request["id"];
+
+      handle_request(request);
+
+    } catch (error_reported_x &) {
+
+    } catch (mtx::input::unsupported_container_x &) {
+      exit_code = 3;
+
+    } catch (mtx::exception &ex) {
+      m_errors.push_back(strip_copy(ex.error(), true));
+
+    } catch (std::exception &ex) {
+      m_errors.push_back(ex.what());
+
+    } catch (...) {
+      m_errors.push_back(Y("An unknown exception occurred."));
+    }
+
+    if (!m_errors.empty())
+      exit_code = 2;
+
+    reset_global_state();
+
+    auto output_lines = split(m_output, "\n");
+    if (!output_lines.empty() && output_lines.back().empty())
+      output_lines.pop_back();
+
+    auto response = (boost::format("{\"id\":%1%,\"exit_code\":%2%,\"output\":%3%,\"warnings\":%4%,\"errors\":%5%}\n")
+                     % json_string(id) % exit_code % json_string_array(output_lines) % json_string_array(m_warnings) % json_string_array(m_errors)).str();
+
+    g_mm_stdio->puts(response);
+    g_mm_stdio->flush();
+  }
+
+  // Identification modifies global state that is normally set up once
+  // per process. An error can leave it in any state. Nothing may be
+  // carried over to the next request.
+  void
+  reset_global_state() {
+    g_files.clear();
+    g_packetizers.clear();
+    g_attachments.clear();
+
+    g_file_sizes        = 0;
+    g_video_fps         = -1.0;
+    g_segment_title_set = false;
+    g_identifying       = false;
+    g_identify_verbose  = false;
+    g_identify_for_mmg  = false;
+
+    g_segment_title.clear();
+  }
+
+  void
+  handle_request(request_t &request) {
+    auto const &action = request["action"];
+
+    if (action == "identify") {
+      handle_identify(request);
+      return;
+    }
+
+    if (action == "mux")
+      throw server_error_x{Y("Muxing is not supported in server mode. Run a separate mkvmerge process for each file to create.")};
+
+    throw server_error_x{boost::format(Y("Unknown action '%1%'.")) % action};
+  }
+
+  void
+  handle_identify(request_t &request) {
+    auto file_name = request["file"];
+    auto mode      = request["mode"];
+
+    if (file_name.empty())
+      throw server_error_x{Y("No file name given.")};
+
+    if (!mode.empty() && (mode != "normal") && (mode != "verbose") && (mode != "mmg"))
+      throw server_error_x{boost::format(Y("Unknown identification mode '%1%'.")) % mode};
+
+    g_identify_verbose = (mode == "verbose") || (mode == "mmg");
+    g_identify_for_mmg = mode == "mmg";
+
+    m_identify(file_name);
+  }
+};
+
+}
+
+void
+run_server_mode(identify_function_t const &identify) {
+  server_c{identify}.run();
+}
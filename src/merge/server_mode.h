@@ -0,0 +1,23 @@
+/*
+   mkvmerge -- utility for splicing together matroska files
+   from component media subtypes
+
+   Distributed under the GPL v2
+   see the file COPYING for details
+   or visit http://www.gnu.org/copyleft/gpl.html
+
+   server mode: handling requests read from stdin
+
+   Written by Moritz Bunkus <moritz@bunkus.org>.
+*/
+
+#ifndef MTX_MERGE_SERVER_MODE_H
+#define MTX_MERGE_SERVER_MODE_H
+
+#include "common/common_pch.h"
+
+using identify_function_t = std::function<void(std::string &)>;
+
+void run_server_mode(identify_function_t const &identify);
+
+#endif // MTX_MERGE_SERVER_MODE_H
@@ -17,19 +17,34 @@
 
 #include "common/common_pch.h"
 
+#include <array>
 #include <boost/optional.hpp>
 
 class track_statistics_c {
 private:
+  // The peak bitrate is determined over a window of one second that
+  // slides in steps of 100ms. Only the byte counts of the ten buckets
+  // within the current window are kept.
+  static int64_t const s_peak_bucket_duration = 100000000;
+  static size_t const s_num_peak_buckets      = 10;
+
   boost::optional<int64_t> m_min_timecode, m_max_timecode_and_duration;
   uint64_t m_num_bytes, m_num_frames;
 
+  std::array<uint64_t, s_num_peak_buckets> m_peak_buckets;
+  boost::optional<int64_t> m_newest_peak_bucket;
+  uint64_t m_peak_window_bytes, m_peak_bytes;
+
 public:
   track_statistics_c()
     : m_min_timecode{}
     , m_max_timecode_and_duration{}
     , m_num_bytes{}
     , m_num_frames{}
+    , m_peak_buckets{}
+    , m_newest_peak_bucket{}
+    , m_peak_window_bytes{}
+    , m_peak_bytes{}
   {
   }
 
@@ -55,7 +70,23 @@ public:
 
   boost::optional<int64_t> get_bits_per_second() const {
     auto duration = get_duration();
-    return duration && (*duration != 0) ? ((m_num_bytes * 8000) / (*duration / 1000000)) : boost::optional<int64_t>{};
+    return duration && ((*duration / 1000000) != 0) ? ((m_num_bytes * 8000) / (*duration / 1000000)) : boost::optional<int64_t>{};
+  }
+
+  // Tracks shorter than one second never fill a whole window. Their
+  // peak is scaled by the duration actually covered the same way the
+  // average is.
+  boost::optional<int64_t> get_peak_bits_per_second() const {
+    if (!is_valid())
+      return boost::optional<int64_t>{};
+
+    auto peak_bytes = std::max(m_peak_bytes, m_peak_window_bytes);
+    auto duration   = *get_duration();
+
+    if (duration >= (s_peak_bucket_duration * static_cast<int64_t>(s_num_peak_buckets)))
+      return peak_bytes * 8;
+
+    return (duration / 1000000) != 0 ? ((peak_bytes * 8000) / (duration / 1000000)) : boost::optional<int64_t>{};
   }
 
   void process(packet_t const &pack) {
@@ -63,18 +94,57 @@ public:
     m_num_bytes                 += pack.data->get_size();
     m_min_timecode               = std::min(pack.assigned_timecode,                       m_min_timecode              ? *m_min_timecode              : std::numeric_limits<int64_t>::max());
     m_max_timecode_and_duration  = std::max(pack.assigned_timecode + pack.get_duration(), m_max_timecode_and_duration ? *m_max_timecode_and_duration : std::numeric_limits<int64_t>::min());
+
+    add_to_peak_window(pack.assigned_timecode, pack.data->get_size());
   }
 
   std::string to_string() const {
     auto duration = get_duration();
     auto bps      = get_bits_per_second();
-    return (boost::format("<#b:%1% #f:%2% min:%3% max:%4% dur:%5% bps:%6%>")
+    auto peak_bps = get_peak_bits_per_second();
+    return (boost::format("<#b:%1% #f:%2% min:%3% max:%4% dur:%5% bps:%6% peak_bps:%7%>")
             % m_num_bytes
             % m_num_frames
             % (m_min_timecode              ? *m_min_timecode              : -1)
             % (m_max_timecode_and_duration ? *m_max_timecode_and_duration : -1)
             % (duration                    ? *duration                    : -1)
-            % (bps                         ? *bps                         : -1)).str();
+            % (bps                         ? *bps                         : -1)
+            % (peak_bps                    ? *peak_bps                    : -1)).str();
+  }
+
+private:
+  void add_to_peak_window(int64_t timecode,
+                          uint64_t num_bytes) {
+    auto num_buckets = static_cast<int64_t>(s_num_peak_buckets);
+    auto bucket      = (0 <= timecode ? timecode : timecode - s_peak_bucket_duration + 1) / s_peak_bucket_duration;
+
+    if (!m_newest_peak_bucket)
+      m_newest_peak_bucket = bucket;
+
+    else if (bucket > *m_newest_peak_bucket) {
+      // The window ending with the newest bucket is complete.
+      m_peak_bytes = std::max(m_peak_bytes, m_peak_window_bytes);
+
+      if ((bucket - *m_newest_peak_bucket) >= num_buckets) {
+        m_peak_buckets.fill(0);
+        m_peak_window_bytes = 0;
+
+      } else
+        for (auto to_drop = *m_newest_peak_bucket + 1; to_drop <= bucket; ++to_drop) {
+          auto &dropped        = m_peak_buckets[((to_drop % num_buckets) + num_buckets) % num_buckets];
+          m_peak_window_bytes -= dropped;
+          dropped              = 0;
+        }
+
+      m_newest_peak_bucket = bucket;
+
+    } else
+      // Frames are not always in timecode order (e.g. B frames). Ones
+      // older than the window are accounted for in its oldest bucket.
+      bucket = std::max(bucket, *m_newest_peak_bucket - num_buckets + 1);
+
+    m_peak_buckets[((bucket % num_buckets) + num_buckets) % num_buckets] += num_bytes;
+    m_peak_window_bytes                                                   += num_bytes;
   }
 };
 
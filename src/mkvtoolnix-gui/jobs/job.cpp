@@ -45,6 +45,12 @@ Job::setStatus(Status status) {
   emit statusChanged(m_id, m_status);
 }
 
+QString
+Job::destinationDirectory()
+  const {
+  return QString{};
+}
+
 bool
 Job::isToBeProcessed()
   const {
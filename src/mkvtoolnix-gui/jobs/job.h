@@ -63,6 +63,7 @@ public:
 
   virtual QString displayableType() const = 0;
   virtual QString displayableDescription() const = 0;
+  virtual QString destinationDirectory() const;
 
   void setPendingAuto();
 
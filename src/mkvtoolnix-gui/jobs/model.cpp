@@ -1,8 +1,12 @@
 #include "common/common_pch.h"
 
 #include <QAbstractItemView>
+#include <QDir>
 #include <QMutexLocker>
 #include <QSettings>
+#if QT_VERSION >= QT_VERSION_CHECK(5, 4, 0)
+# include <QStorageInfo>
+#endif
 #include <QTimer>
 
 #include "common/qt.h"
@@ -220,24 +224,71 @@ Model::startNextAutoJob() {
   if (!m_started)
     return;
 
-  Job *toStart = nullptr;
-  for (auto row = 0, numRows = rowCount(); row < numRows; ++row) {
-    auto job = m_jobsById[idFromRow(row)].get();
+  auto const &cfg     = Util::Settings::get();
+  auto maxJobs        = std::max(cfg.m_maximumConcurrentJobs, 1u);
+  auto maxJobsPerDisk = cfg.m_maximumJobsPerDisk;
+
+  // Starting a job changes its status which in turn calls this
+  // function recursively. Therefore the running jobs are counted anew
+  // before each job is started.
+  while (true) {
+    auto numRunning        = 0u;
+    auto numRunningPerDisk = QHash<QString, unsigned int>{};
+    auto pendingJobs       = QList<Job *>{};
+
+    for (auto row = 0, numRows = rowCount(); row < numRows; ++row) {
+      auto job = m_jobsById[idFromRow(row)].get();
+
+      if (Job::Running == job->m_status) {
+        ++numRunning;
+        ++numRunningPerDisk[diskOfDestination(*job)];
+
+      } else if (Job::PendingAuto == job->m_status)
+        pendingJobs << job;
+    }
 
-    if (Job::Running == job->m_status)
+    if (!numRunning && pendingJobs.isEmpty()) {
+      // All jobs are done. Clear total progress.
+      m_toBeProcessed.clear();
+      updateProgress();
+      return;
+    }
+
+    if (numRunning >= maxJobs)
+      return;
+
+    Job *toStart = nullptr;
+    for (auto const &job : pendingJobs) {
+      auto disk = diskOfDestination(*job);
+      if (!maxJobsPerDisk || disk.isEmpty() || (numRunningPerDisk[disk] < maxJobsPerDisk)) {
+        toStart = job;
+        break;
+      }
+    }
+
+    if (!toStart)
       return;
-    if (!toStart && (Job::PendingAuto == job->m_status))
-      toStart = job;
-  }
 
-  if (toStart) {
     toStart->start();
-    return;
+
+    if (Job::PendingAuto == toStart->m_status)
+      return;
   }
+}
 
-  // All jobs are done. Clear total progress.
-  m_toBeProcessed.clear();
-  updateProgress();
+QString
+Model::diskOfDestination(Job const &job) {
+  auto directory = job.destinationDirectory();
+  if (directory.isEmpty())
+    return directory;
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 4, 0)
+  auto storage = QStorageInfo{directory};
+  if (storage.isValid())
+    return storage.rootPath();
+#endif
+
+  return QDir{directory}.absolutePath();
 }
 
 void
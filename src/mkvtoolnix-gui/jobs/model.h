@@ -74,6 +74,8 @@ protected:
   void updateProgress();
   void processAutomaticJobRemoval(uint64_t id, Job::Status status);
   void scheduleJobForRemoval(uint64_t id);
+
+  static QString diskOfDestination(Job const &job);
 };
 
 }}}
@@ -147,6 +147,12 @@ MuxJob::displayableDescription()
   return QY("merging to file »%1« in directory »%2«").arg(info.fileName()).arg(info.filePath());
 }
 
+QString
+MuxJob::destinationDirectory()
+  const {
+  return QFileInfo{m_config->m_destination}.absolutePath();
+}
+
 void
 MuxJob::saveJobInternal(QSettings &settings)
   const {
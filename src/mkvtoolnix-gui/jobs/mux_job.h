@@ -39,6 +39,7 @@ public:
 
   virtual QString displayableType() const;
   virtual QString displayableDescription() const;
+  virtual QString destinationDirectory() const;
 
 public slots:
   void readAvailable();
@@ -235,8 +235,13 @@ MainWindow::closeEvent(QCloseEvent *event) {
 void
 MainWindow::editPreferences() {
   PreferencesDialog dlg{this};
-  if (dlg.exec())
-    dlg.save();
+  if (!dlg.exec())
+    return;
+
+  dlg.save();
+
+  // The number of concurrent jobs might have been raised.
+  m_toolJobs->getModel()->startNextAutoJob();
 }
 
 #if defined(HAVE_CURL_EASY_H)
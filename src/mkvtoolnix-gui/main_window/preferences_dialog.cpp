@@ -113,6 +113,9 @@ PreferencesDialog::setupJobsJobOutput() {
   ui->cbGuiRemoveJobs->setChecked(doRemove);
   ui->cbGuiJobRemovalPolicy->setEnabled(doRemove);
   ui->cbGuiJobRemovalPolicy->setCurrentIndex(idx);
+
+  ui->sbGuiMaximumConcurrentJobs->setValue(m_cfg.m_maximumConcurrentJobs);
+  ui->sbGuiMaximumJobsPerDisk->setValue(m_cfg.m_maximumJobsPerDisk);
 }
 
 void
@@ -228,6 +231,8 @@ PreferencesDialog::save() {
   m_cfg.m_checkForUpdates           = ui->cbGuiCheckForUpdates->isChecked();
   auto idx                          = !ui->cbGuiRemoveJobs->isChecked() ? 0 : ui->cbGuiJobRemovalPolicy->currentIndex() + 1;
   m_cfg.m_jobRemovalPolicy          = static_cast<Util::Settings::JobRemovalPolicy>(idx);
+  m_cfg.m_maximumConcurrentJobs     = ui->sbGuiMaximumConcurrentJobs->value();
+  m_cfg.m_maximumJobsPerDisk        = ui->sbGuiMaximumJobsPerDisk->value();
 
   saveCommonList(*ui->lwGuiSelectedCommonLanguages,     m_cfg.m_oftenUsedLanguages);
   saveCommonList(*ui->lwGuiSelectedCommonCountries,     m_cfg.m_oftenUsedCountries);
@@ -8,15 +8,116 @@
 #include "mkvtoolnix-gui/util/util.h"
 
 #include <QApplication>
+#include <QAtomicInt>
+#include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
+#include <QHash>
+#include <QMessageBox>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QProgressDialog>
+#include <QRunnable>
 #include <QString>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
 
 namespace mtx { namespace gui { namespace Merge {
 
 using namespace mtx::gui;
 
+namespace {
+
+struct IdentificationResult {
+  qint64 m_size{-1};
+  QDateTime m_lastModified;
+  int m_exitCode{-1};
+  QStringList m_output;
+};
+
+// mkvmerge's identification output for files scanned earlier. Entries
+// are only used if the file's size and modification time haven't
+// changed since.
+QHash<QString, IdentificationResult> s_identificationCache;
+QMutex s_identificationCacheMutex;
+
+class IdentificationTask: public QRunnable {
+protected:
+  QFileInfo m_file;
+  IdentificationResult &m_result;
+  QAtomicInt &m_numScanned, &m_canceled;
+
+public:
+  IdentificationTask(QFileInfo const &file,
+                     IdentificationResult &result,
+                     QAtomicInt &numScanned,
+                     QAtomicInt &canceled)
+    : m_file{file}
+    , m_result(result)
+    , m_numScanned(numScanned)
+    , m_canceled(canceled)
+  {
+  }
+
+  virtual void
+  run() override {
+    // Exceptions must not escape into the thread pool, and the task
+    // must always be counted as finished. A failure is recorded like a
+    // file mkvmerge couldn't identify.
+    try {
+      if (!m_canceled.load())
+        identify();
+
+    } catch (std::exception const &ex) {
+      setFailed(Q(ex.what()));
+
+    } catch (...) {
+      setFailed(QY("Unknown error"));
+    }
+
+    m_numScanned.ref();
+  }
+
+protected:
+  void
+  setFailed(QString const &message) {
+    m_result.m_exitCode = 2;
+    m_result.m_output   = QStringList{} << message;
+  }
+
+  void
+  identify() {
+    auto fileName = m_file.absoluteFilePath();
+
+    m_result.m_size         = m_file.size();
+    m_result.m_lastModified = m_file.lastModified();
+
+    {
+      QMutexLocker locked{&s_identificationCacheMutex};
+
+      auto cached = s_identificationCache.constFind(fileName);
+      if (   (cached != s_identificationCache.constEnd())
+          && (cached->m_size         == m_result.m_size)
+          && (cached->m_lastModified == m_result.m_lastModified)) {
+        m_result = *cached;
+        return;
+      }
+    }
+
+    Util::FileIdentifier identifier{nullptr, m_file.filePath()};
+    identifier.runMkvmerge();
+
+    m_result.m_exitCode = identifier.exitCode();
+    m_result.m_output   = identifier.output();
+
+    QMutexLocker locked{&s_identificationCacheMutex};
+    s_identificationCache[fileName] = m_result;
+  }
+};
+
+}
+
 PlaylistScanner::PlaylistScanner(QWidget *parent)
   : m_parent{parent}
 {
@@ -71,27 +172,68 @@ PlaylistScanner::scanForPlaylists(QFileInfoList const &otherFiles) {
   QProgressDialog progress{ QY("Scanning directory"), QY("Cancel"), 0, otherFiles.size(), m_parent };
   progress.setWindowModality(Qt::ApplicationModal);
 
-  auto identifiedFiles = QList<SourceFilePtr>{};
-  auto numScanned      = 0u;
+  // Identify the files with several mkvmerge processes running in
+  // parallel. Each task only runs mkvmerge; the output is parsed here
+  // in the GUI thread afterwards.
+  auto results = QVector<IdentificationResult>(otherFiles.size());
+  QAtomicInt numScanned, canceled;
+
+  QThreadPool pool;
+  pool.setMaxThreadCount(std::max(QThread::idealThreadCount(), 1));
+
+  for (auto idx = 0, numFiles = otherFiles.size(); idx < numFiles; ++idx)
+    pool.start(new IdentificationTask{otherFiles[idx], results[idx], numScanned, canceled});
+
+  while (!pool.waitForDone(50)) {
+    auto numScannedNow = numScanned.load();
 
-  for (auto const &otherFile : otherFiles) {
-    progress.setLabelText(QNY("%1 of %2 file processed", "%1 of %2 files processed", otherFiles.size()).arg(numScanned).arg(otherFiles.size()));
-    progress.setValue(numScanned++);
+    progress.setLabelText(QNY("%1 of %2 file processed", "%1 of %2 files processed", otherFiles.size()).arg(numScannedNow).arg(otherFiles.size()));
+    progress.setValue(numScannedNow);
 
     qApp->processEvents();
     if (progress.wasCanceled())
-      return QList<SourceFilePtr>{};
+      canceled.store(1);
+  }
+
+  progress.setValue(otherFiles.size());
+
+  if (canceled.load())
+    return QList<SourceFilePtr>{};
+
+  auto identifiedFiles = QList<SourceFilePtr>{};
+  auto failedFiles     = QStringList{};
+
+  for (auto idx = 0, numFiles = otherFiles.size(); idx < numFiles; ++idx) {
+    Util::FileIdentifier identifier{m_parent, otherFiles[idx].filePath()};
+    identifier.setOutput(results[idx].m_exitCode, results[idx].m_output);
+
+    // Failures are collected and reported once all files have been
+    // processed instead of showing one message box per file.
+    if (3 == results[idx].m_exitCode) {
+      failedFiles << QY("%1: unsupported container format (%2)").arg(otherFiles[idx].fileName()).arg(identifier.unsupportedContainer());
+      continue;
+    }
 
-    Util::FileIdentifier identifier{m_parent, otherFile.filePath()};
-    if (!identifier.identify())
+    if (0 != results[idx].m_exitCode) {
+      failedFiles << QY("%1: not recognized as a supported format (exit code: %2)").arg(otherFiles[idx].fileName()).arg(results[idx].m_exitCode);
       continue;
+    }
+
+    if (!identifier.parseOutput()) {
+      failedFiles << QY("%1: the identification result could not be parsed").arg(otherFiles[idx].fileName());
+      continue;
+    }
 
     auto file = identifier.file();
     if (file->isPlaylist() && (file->m_playlistDuration >= (Util::Settings::get().m_minimumPlaylistDuration * 1000000000ull)))
       identifiedFiles << file;
   }
 
-  progress.setValue(otherFiles.size());
+  if (!failedFiles.isEmpty())
+    QMessageBox::warning(m_parent, QY("Files not identified"),
+                         QNY("The following file could not be identified and was skipped while scanning for playlists:\n%1",
+                             "The following files could not be identified and were skipped while scanning for playlists:\n%1",
+                             failedFiles.size()).arg(failedFiles.join(Q("\n"))));
 
   std::sort(identifiedFiles.begin(), identifiedFiles.end(), [](SourceFilePtr const &a, SourceFilePtr const &b) { return a->m_fileName < b->m_fileName; });
 
@@ -30,30 +30,35 @@ FileIdentifier::identify() {
   if (m_fileName.isEmpty())
     return false;
 
-  QStringList args;
-  args << "--output-charset" << "utf-8" << "--identify-for-mmg" << m_fileName;
+  runMkvmerge();
 
-  auto process  = Process::execute(Settings::get().actualMkvmergeExe(), args);
-  auto exitCode = process->process().exitCode();
-  m_output      = process->output();
-
-  if (0 == exitCode)
+  if (0 == m_exitCode)
     return parseOutput();
 
-  if (3 == exitCode) {
-    auto pos       = m_output.isEmpty() ? -1            : m_output[0].indexOf("container:");
-    auto container = -1 == pos          ? QY("unknown") : m_output[0].mid(pos + 11);
-
-    QMessageBox::critical(m_parent, QY("Unsupported file format"), QY("The file is an unsupported container format (%1).").arg(container));
+  if (3 == m_exitCode) {
+    QMessageBox::critical(m_parent, QY("Unsupported file format"), QY("The file is an unsupported container format (%1).").arg(unsupportedContainer()));
 
     return false;
   }
 
-  QMessageBox::critical(m_parent, QY("Unrecognized file format"), QY("The file was not recognized as a supported format (exit code: %1).").arg(exitCode));
+  QMessageBox::critical(m_parent, QY("Unrecognized file format"), QY("The file was not recognized as a supported format (exit code: %1).").arg(m_exitCode));
 
   return false;
 }
 
+// Only runs mkvmerge and stores its exit code and output. Neither
+// parses the output nor shows any message, and can therefore be used
+// from other threads than the GUI thread.
+void
+FileIdentifier::runMkvmerge() {
+  QStringList args;
+  args << "--output-charset" << "utf-8" << "--identify-for-mmg" << m_fileName;
+
+  auto process = Process::execute(Settings::get().actualMkvmergeExe(), args);
+  m_exitCode   = process->process().exitCode();
+  m_output     = process->output();
+}
+
 QString const &
 FileIdentifier::fileName()
   const {
@@ -77,6 +82,22 @@ FileIdentifier::output()
   return m_output;
 }
 
+// The container format mkvmerge reported as unsupported with exit
+// code 3.
+QString
+FileIdentifier::unsupportedContainer()
+  const {
+  auto pos = m_output.isEmpty() ? -1 : m_output[0].indexOf("container:");
+  return -1 == pos ? QY("unknown") : m_output[0].mid(pos + 11);
+}
+
+void
+FileIdentifier::setOutput(int exitCode,
+                          QStringList const &output) {
+  m_exitCode = exitCode;
+  m_output   = output;
+}
+
 Merge::SourceFilePtr const &
 FileIdentifier::file()
   const {
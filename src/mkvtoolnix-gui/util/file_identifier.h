@@ -25,6 +25,7 @@ public:
   virtual ~FileIdentifier();
 
   virtual bool identify();
+  virtual void runMkvmerge();
   virtual bool parseOutput();
   virtual QHash<QString, QString> parseProperties(QString const &line) const;
   virtual void parseAttachmentLine(QString const &line);
@@ -39,6 +40,8 @@ public:
 
   virtual int exitCode() const;
   virtual QStringList const &output() const;
+  virtual QString unsupportedContainer() const;
+  virtual void setOutput(int exitCode, QStringList const &output);
 
   virtual mtx::gui::Merge::SourceFilePtr const &file() const;
 };
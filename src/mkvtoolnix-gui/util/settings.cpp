@@ -59,6 +59,8 @@ Settings::load() {
   m_fixedOutputDir            = QDir{reg.value("fixedOutputDir").toString()};
 
   m_jobRemovalPolicy          = static_cast<JobRemovalPolicy>(reg.value("jobRemovalPolicy", static_cast<int>(JobRemovalPolicy::Never)).toInt());
+  m_maximumConcurrentJobs     = std::max(reg.value("maximumConcurrentJobs", 1).toUInt(), 1u);
+  m_maximumJobsPerDisk        = reg.value("maximumJobsPerDisk", 0).toUInt();
 
   reg.beginGroup("updates");
   m_checkForUpdates = reg.value("checkForUpdates", true).toBool();
@@ -120,6 +122,8 @@ Settings::save()
   reg.setValue("uniqueOutputFileNames",     m_uniqueOutputFileNames);
 
   reg.setValue("jobRemovalPolicy",          static_cast<int>(m_jobRemovalPolicy));
+  reg.setValue("maximumConcurrentJobs",     m_maximumConcurrentJobs);
+  reg.setValue("maximumJobsPerDisk",        m_maximumJobsPerDisk);
 
   reg.beginGroup("updates");
   reg.setValue("checkForUpdates", m_checkForUpdates);
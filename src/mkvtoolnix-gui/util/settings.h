@@ -58,6 +58,7 @@ public:
   unsigned int m_minimumPlaylistDuration;
 
   JobRemovalPolicy m_jobRemovalPolicy;
+  unsigned int m_maximumConcurrentJobs, m_maximumJobsPerDisk;
 
   bool m_checkForUpdates;
   QDateTime m_lastUpdateCheck;
@@ -24,9 +24,26 @@ Tab::~Tab() {
 
 void
 Tab::connectToJob(Jobs::Job const &job) {
-  connect(&job, SIGNAL(statusChanged(uint64_t,mtx::gui::Jobs::Job::Status)),    this, SLOT(onStatusChanged(uint64_t,mtx::gui::Jobs::Job::Status)));
+  connect(&job, SIGNAL(statusChanged(uint64_t,mtx::gui::Jobs::Job::Status)), this, SLOT(onStatusChanged(uint64_t,mtx::gui::Jobs::Job::Status)));
+}
+
+// Several jobs can run at the same time, but the tab only shows the
+// one started most recently. Only that job's progress and output are
+// connected.
+void
+Tab::switchToJob(Jobs::Job const &job) {
+  auto previousJob = m_currentJobId ? MainWindow::getJobTool()->getModel()->fromId(*m_currentJobId) : nullptr;
+  if (previousJob) {
+    disconnect(previousJob, SIGNAL(progressChanged(uint64_t,unsigned int)),                 this, SLOT(onProgressChanged(uint64_t,unsigned int)));
+    disconnect(previousJob, SIGNAL(lineRead(const QString&,mtx::gui::Jobs::Job::LineType)), this, SLOT(onLineRead(const QString&,mtx::gui::Jobs::Job::LineType)));
+  }
+
+  m_currentJobId = job.m_id;
+
   connect(&job, SIGNAL(progressChanged(uint64_t,unsigned int)),                 this, SLOT(onProgressChanged(uint64_t,unsigned int)));
   connect(&job, SIGNAL(lineRead(const QString&,mtx::gui::Jobs::Job::LineType)), this, SLOT(onLineRead(const QString&,mtx::gui::Jobs::Job::LineType)));
+
+  setInitialDisplay(job);
 }
 
 void
@@ -36,12 +53,15 @@ Tab::onStatusChanged(uint64_t id,
   if (!job)
     return;
 
-  ui->status->setText(Jobs::Job::displayableStatus(status));
-
   if (Jobs::Job::Running == status)
-    setInitialDisplay(*job);
+    switchToJob(*job);
+
+  else if (!m_currentJobId || (*m_currentJobId != id))
+    return;
+
+  ui->status->setText(Jobs::Job::displayableStatus(status));
 
-  else if ((Jobs::Job::DoneOk == status) || (Jobs::Job::DoneWarnings == status) || (Jobs::Job::Failed == status) || (Jobs::Job::Aborted == status))
+  if ((Jobs::Job::DoneOk == status) || (Jobs::Job::DoneWarnings == status) || (Jobs::Job::Failed == status) || (Jobs::Job::Aborted == status))
     ui->finishedAt->setText(Util::displayableDate(job->m_dateFinished));
 }
 
@@ -5,6 +5,8 @@
 
 #include <QWidget>
 
+#include <boost/optional.hpp>
+
 #include "mkvtoolnix-gui/jobs/job.h"
 
 namespace mtx { namespace gui { namespace WatchJobs {
@@ -20,6 +22,8 @@ protected:
   // UI stuff:
   std::unique_ptr<Ui::Tab> ui;
 
+  boost::optional<uint64_t> m_currentJobId;
+
 public:
   explicit Tab(QWidget *parent);
   ~Tab();
@@ -36,6 +40,7 @@ public slots:
   void onSaveOutput();
 
 protected:
+  void switchToJob(mtx::gui::Jobs::Job const &job);
 };
 
 }}}
@@ -156,6 +156,9 @@ cli_options_dlg::init_cli_option_list() {
                                            Z("Garbage at the start of audio tracks in AVI files is normally used for delaying that track. "
                                              "mkvmerge normally calculates the delay implied by its presence and offsets all of the track's timecodes by it. "
                                              "This option prevents that behavior.")));
+  all_cli_options.push_back(cli_option_t(wxU("--engage regex_text_subtitle_parsers"),
+                                           Z("Makes mkvmerge use the older parsers based on regular expressions for SRT and SSA/ASS subtitles. "
+                                             "They are a lot slower but can be used as a fallback for files the normal parsers handle differently.")));
   all_cli_options.push_back(cli_option_t(wxU("--engage cow"),
                                            Z("No help available.")));
 }
@@ -27,6 +27,30 @@
 
 #define BUFF_SIZE 2*1024*1024
 
+//The queues are ring buffers that grow when they're full.
+template<typename T>
+static void
+GrowRingIfFull(boost::circular_buffer<T> &ring) {
+  if (ring.full())
+    ring.set_capacity(std::max<size_t>(ring.capacity() * 2, 16));
+}
+
+template<typename T>
+static void
+PushToRing(boost::circular_buffer<T> &ring,
+           T const &value) {
+  GrowRingIfFull(ring);
+  ring.push_back(value);
+}
+
+//Sequence and GOP headers are kept around until the next frame is
+//output. They're small, so they're copied instead of keeping the
+//video buffer's storage they're sliced from alive.
+static MPEGChunkPtr
+CopyChunk(MPEGChunk *chunk) {
+  return std::make_shared<MPEGChunk>(memory_c::clone(chunk->GetPointer(), chunk->GetSize()));
+}
+
 void MPEGFrameRef::TryUpdate(){
   // if frame set, stamped and no timecode yet, derive it
   if (frame && frame->stamped && (timecode == -1))
@@ -56,13 +80,13 @@ MPEGFrame::~MPEGFrame(){
 }
 
 void M2VParser::SetEOS(){
-  MPEGChunk * c;
+  MPEGChunkPtr c;
   while((c = mpgBuf->ReadChunk())){
-    chunks.push_back(c);
+    PushToRing(chunks, c);
   }
   mpgBuf->ForceFinal();  //Force the last frame out.
   c = mpgBuf->ReadChunk();
-  if(c) chunks.push_back(c);
+  if(c) PushToRing(chunks, c);
   FillQueues();
   TimestampWaitingFrames();
   m_eos = true;
@@ -80,8 +104,8 @@ int32_t M2VParser::WriteData(binary* data, uint32_t dataSize){
 
   //Fill the chunks buffer
   while(mpgBuf->GetState() == MPEG2_BUFFER_STATE_CHUNK_READY){
-    MPEGChunk * c = mpgBuf->ReadChunk();
-    if(c) chunks.push_back(c);
+    MPEGChunkPtr c = mpgBuf->ReadChunk();
+    if(c) PushToRing(chunks, c);
   }
 
   if(needInit){
@@ -100,14 +124,10 @@ int32_t M2VParser::WriteData(binary* data, uint32_t dataSize){
 }
 
 void M2VParser::DumpQueues(){
-  while(!chunks.empty()){
-    delete chunks.front();
-    chunks.erase(chunks.begin());
-  }
-  while(!buffers.empty()){
-    delete buffers.front();
-    buffers.pop();
-  }
+  chunks.clear();
+  for (auto const &frame : buffers)
+    delete frame;
+  buffers.clear();
 }
 
 M2VParser::M2VParser()
@@ -131,22 +151,15 @@ M2VParser::M2VParser()
   gopPts = 0;
   highestPts = 0;
   usePictureFrames = false;
-  seqHdrChunk = nullptr;
-  gopChunk = nullptr;
   keepSeqHdrsInBitstream = true;
 }
 
 int32_t M2VParser::InitParser(){
   //Gotta find a sequence header now
-  MPEGChunk* chunk;
-  //MPEGChunk* seqHdrChunk;
   for(size_t i = 0; i < chunks.size(); i++){
-    chunk = chunks[i];
+    MPEGChunk* chunk = chunks[i].get();
     if(chunk->GetType() == MPEG_VIDEO_SEQUENCE_START_CODE){
-      //Copy the header for later, we must copy because the actual chunk will be deleted in a bit
-      binary * hdrData = new binary[chunk->GetSize()];
-      memcpy(hdrData, chunk->GetPointer(), chunk->GetSize());
-      seqHdrChunk = new MPEGChunk(hdrData, chunk->GetSize()); //Save this for adding as private data...
+      seqHdrChunk = CopyChunk(chunk); //Save this for adding as private data...
       ParseSequenceHeader(chunk, m_seqHdr);
 
       //Look for sequence extension to identify mpeg2
@@ -166,8 +179,6 @@ int32_t M2VParser::InitParser(){
 M2VParser::~M2VParser(){
   DumpQueues();
   FlushWaitQueue();
-  delete seqHdrChunk;
-  delete gopChunk;
   delete mpgBuf;
 }
 
@@ -207,10 +218,9 @@ void M2VParser::FlushWaitQueue(){
 
   for (auto const &frame : waitQueue)
     delete frame;
-  while (!buffers.empty()) {
-    delete buffers.front();
-    buffers.pop();
-  }
+  for (auto const &frame : buffers)
+    delete frame;
+  buffers.clear();
 
   waitQueue.clear();
   m_timecodes.clear();
@@ -289,11 +299,11 @@ M2VParser::TimestampWaitingFrames() {
   brng::sort(waitQueue, [](MPEGFrame *a, MPEGFrame *b) { return a->decodingOrder < b->decodingOrder; });
 
   for (auto const &frame : waitQueue)
-    buffers.push(frame);
+    PushToRing(buffers, frame);
   waitQueue.clear();
 }
 
-int32_t M2VParser::PrepareFrame(MPEGChunk* chunk, MediaTime timecode, MPEG2PictureHeader picHdr){
+int32_t M2VParser::PrepareFrame(MPEGChunkPtr const &chunk, MediaTime timecode, MPEG2PictureHeader picHdr){
   MPEGFrame* outBuf;
   bool bCopy = true;
   binary* pData = chunk->GetPointer();
@@ -311,14 +321,12 @@ int32_t M2VParser::PrepareFrame(MPEGChunk* chunk, MediaTime timecode, MPEG2Pictu
         (MPEG2_I_FRAME == picHdr.frameType)) {
       memcpy(pData, seqHdrChunk->GetPointer(), seqHdrChunk->GetSize());
       pos += seqHdrChunk->GetSize();
-      delete seqHdrChunk;
-      seqHdrChunk = nullptr;
+      seqHdrChunk.reset();
     }
     if (gopChunk) {
       memcpy(pData + pos, gopChunk->GetPointer(), gopChunk->GetSize());
       pos += gopChunk->GetSize();
-      delete gopChunk;
-      gopChunk = nullptr;
+      gopChunk.reset();
     }
     memcpy(pData + pos, chunk->GetPointer(), chunk->GetSize());
   }
@@ -331,8 +339,7 @@ int32_t M2VParser::PrepareFrame(MPEGChunk* chunk, MediaTime timecode, MPEG2Pictu
     outBuf->seqHdrDataSize = seqHdrChunk->GetSize();
     memcpy(outBuf->seqHdrData, seqHdrChunk->GetPointer(),
            outBuf->seqHdrDataSize);
-    delete seqHdrChunk;
-    seqHdrChunk = nullptr;
+    seqHdrChunk.reset();
   }
 
   if(picHdr.frameType == MPEG2_I_FRAME){
@@ -386,16 +393,14 @@ int32_t M2VParser::FillQueues(){
   bool done = false;
   while(!done){
     MediaTime myTime;
-    MPEGChunk* chunk = chunks.front();
+    MPEGChunkPtr chunk = chunks.front();
     while (chunk->GetType() != MPEG_VIDEO_PICTURE_START_CODE) {
       if (chunk->GetType() == MPEG_VIDEO_GOP_START_CODE) {
-        ParseGOPHeader(chunk, m_gopHdr);
+        ParseGOPHeader(chunk.get(), m_gopHdr);
         if (frameNum != 0) {
           gopPts = highestPts + 1;
         }
-        if (gopChunk)
-          delete gopChunk;
-        gopChunk = chunk;
+        gopChunk = CopyChunk(chunk.get());
         gopNum++;
         /* Perform some sanity checks */
         if(waitSecondField){
@@ -411,20 +416,18 @@ int32_t M2VParser::FillQueues(){
         }
         */
       } else if (chunk->GetType() == MPEG_VIDEO_SEQUENCE_START_CODE) {
-        if (seqHdrChunk)
-          delete seqHdrChunk;
-        ParseSequenceHeader(chunk, m_seqHdr);
-        seqHdrChunk = chunk;
+        ParseSequenceHeader(chunk.get(), m_seqHdr);
+        seqHdrChunk = CopyChunk(chunk.get());
 
       }
 
-      chunks.erase(chunks.begin());
+      chunks.pop_front();
       if (chunks.empty())
         return -1;
       chunk = chunks.front();
     }
     MPEG2PictureHeader picHdr;
-    ParsePictureHeader(chunk, picHdr);
+    ParsePictureHeader(chunk.get(), picHdr);
 
     if (picHdr.pictureStructure == MPEG2_PICTURE_TYPE_FRAME) {
       usePictureFrames = true;
@@ -456,8 +459,7 @@ int32_t M2VParser::FillQueues(){
         PrepareFrame(chunk, myTime, picHdr);
     }
     frameNum++;
-    chunks.erase(chunks.begin());
-    delete chunk;
+    chunks.pop_front();
     if (chunks.empty())
       return -1;
   }
@@ -473,16 +475,14 @@ MPEGFrame* M2VParser::ReadFrame(){
     return nullptr; // OOPS!
   }
   MPEGFrame* frame = buffers.front();
-  buffers.pop();
+  buffers.pop_front();
   return frame;
 }
 
 void
 M2VParser::AddTimecode(int64_t timecode) {
-  std::list<int64_t>::iterator idx = m_timecodes.begin();
-  while ((idx != m_timecodes.end()) && (timecode > *idx))
-    idx++;
-  m_timecodes.insert(idx, timecode);
+  GrowRingIfFull(m_timecodes);
+  m_timecodes.insert(std::lower_bound(m_timecodes.begin(), m_timecodes.end(), timecode), timecode);
 }
 
 void
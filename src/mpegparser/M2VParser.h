@@ -25,8 +25,9 @@
 
 #include "common/common_pch.h"
 
+#include <boost/circular_buffer.hpp>
+
 #include "MPEGVideoBuffer.h"
-#include <queue>
 
 enum MPEG2ParserState_e {
   MPV_PARSER_STATE_FRAME,
@@ -78,13 +79,13 @@ public:
 
 class M2VParser {
 private:
-  std::vector<MPEGChunk*> chunks; //Hold the chunks until we can order them
+  boost::circular_buffer<MPEGChunkPtr> chunks; //Hold the chunks until we can order them
   std::vector<MPEGFrame*> waitQueue; //Holds unstamped buffers until we can stamp them.
-  std::queue<MPEGFrame*> buffers; //Holds stamped buffers until they are requested.
+  boost::circular_buffer<MPEGFrame*> buffers; //Holds stamped buffers until they are requested.
   MediaTime previousTimecode;
   MediaTime previousDuration;
   //Added to allow reading the header's raw data, contains first found seq hdr.
-  MPEGChunk* seqHdrChunk, *gopChunk;
+  MPEGChunkPtr seqHdrChunk, gopChunk;
   MPEG2SequenceHeader m_seqHdr; //current sequence header
   MPEG2GOPHeader m_gopHdr; //current GOP header
   MediaTime waitExpectedTime;
@@ -105,7 +106,7 @@ private:
   uint8_t mpegVersion;
   MPEG2ParserState_e parserState;
   MPEGVideoBuffer * mpgBuf;
-  std::list<int64_t> m_timecodes;
+  boost::circular_buffer<int64_t> m_timecodes;
   bool throwOnError;
 
   int32_t InitParser();
@@ -119,7 +120,7 @@ private:
   int32_t OrderFrame(MPEGFrame* frame);
   void StampFrame(MPEGFrame* frame);
   void UpdateFrame(MPEGFrame* frame);
-  int32_t PrepareFrame(MPEGChunk* chunk, MediaTime timecode, MPEG2PictureHeader picHdr);
+  int32_t PrepareFrame(MPEGChunkPtr const &chunk, MediaTime timecode, MPEG2PictureHeader picHdr);
 public:
   M2VParser();
   virtual ~M2VParser();
@@ -130,7 +131,7 @@ public:
 
   //BE VERY CAREFUL WITH THIS CALL
   MPEGChunk * GetRealSequenceHeader(){
-    return seqHdrChunk;
+    return seqHdrChunk.get();
   }
 
   uint8_t GetMPEGVersion() const{
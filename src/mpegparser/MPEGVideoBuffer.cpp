@@ -37,30 +37,43 @@ MPEG2PictureHeader::MPEG2PictureHeader() {
   memset(this, 0, sizeof(*this));
 }
 
+MPEGVideoBuffer::MPEGVideoBuffer(uint32_t size)
+  : m_block(memory_c::alloc(size))
+  , m_capacity(size)
+  , m_readPos(0)
+  , m_writePos(0)
+  , m_scanPos(0)
+  , state(MPEG2_BUFFER_STATE_EMPTY)
+  , chunkStart(-1)
+  , chunkEnd(-1)
+{
+}
+
 int32_t MPEGVideoBuffer::FindStartCode(uint32_t startPos){
-  //How many bytes can we look through?
-  uint32_t window = myBuffer->GetLength() - startPos;
+  binary* base = m_block->get_buffer() + m_readPos;
+  uint32_t length = GetLength();
 
-  if(window < 4) //Make sure we have enough bytes to search.
+  if((startPos + 4) > length) //Make sure we have enough bytes to search.
     return -1;
 
-  for(unsigned int i = startPos; i < (window - 3); i++){
-    CircBuffer& buf = *myBuffer;
-    binary a,b,c,d;
-    a = buf[i];
-    b = buf[i+1];
-    c = buf[i+2];
-    d = buf[i+3];
-    if((a == 0x00) && (b == 0x00) && (c == 0x01)){
-      switch(d){
+  //Look for the 0x01 of the 00 00 01 prefix; it can be at startPos + 2 at the earliest.
+  binary* pos = base + startPos + 2;
+  binary* end = base + length - 1;
+  while(pos < end){
+    pos = static_cast<binary *>(memchr(pos, 0x01, end - pos));
+    if(!pos)
+      break;
+    if((pos[-1] == 0x00) && (pos[-2] == 0x00)){
+      switch(pos[1]){
         case MPEG_VIDEO_SEQUENCE_START_CODE:
         case MPEG_VIDEO_GOP_START_CODE:
         case MPEG_VIDEO_PICTURE_START_CODE:
-          return i;  //Return our position if we found
+          return pos - 2 - base;  //Return our position if we found
           //one of the codes we want
 
       }
     }
+    pos++;
   }
 
   //If we get here we have no _wanted_ start code found.
@@ -68,21 +81,28 @@ int32_t MPEGVideoBuffer::FindStartCode(uint32_t startPos){
 }
 
 void MPEGVideoBuffer::UpdateState(){
-  assert(myBuffer);
   int32_t test = 0;
-  if(myBuffer->GetLength() == 0){
+  uint32_t length = GetLength();
+  if(length == 0){
     state = MPEG2_BUFFER_STATE_EMPTY;
     return;
   }
+  //Bytes that have been searched before are not searched again. The
+  //last three bytes may be the beginning of a start code, though.
+  uint32_t resumePos = length > 3 ? length - 3 : 0;
   if(chunkStart == -1){
-    test = FindStartCode(0);
+    test = FindStartCode(m_scanPos);
     if(test != -1)  //We found a new startcode
       chunkStart = test;
+    else
+      m_scanPos = resumePos;
   }
-  if(chunkEnd == -1){
-    test = FindStartCode(chunkStart+4);
+  if(chunkStart != -1 && chunkEnd == -1){
+    test = FindStartCode(std::max<uint32_t>(chunkStart + 4, m_scanPos));
     if(test != -1)  //We found a new startcode
       chunkEnd = test;
+    else
+      m_scanPos = std::max<uint32_t>(chunkStart + 4, resumePos);
   }
   if(chunkStart == -1 || chunkEnd == -1){
     state = MPEG2_BUFFER_STATE_NEED_MORE_DATA;
@@ -92,38 +112,79 @@ void MPEGVideoBuffer::UpdateState(){
   }
 }
 
-MPEGChunk * MPEGVideoBuffer::ReadChunk(){
-  MPEGChunk* myChunk = nullptr;
-  if(state == MPEG2_BUFFER_STATE_CHUNK_READY){
-    assert(chunkStart < chunkEnd && chunkStart != -1 && chunkEnd != -1);
-    if(chunkStart != 0){ //we have to skip some bytes
-      myBuffer->Skip(chunkStart);
-    }
-    uint32_t chunkLength = chunkEnd - chunkStart;
-    binary* chunkData = new binary[chunkLength];
-    myBuffer->Read(chunkData, chunkLength);
-    chunkStart = 0; //we read up to the next start code
-    chunkEnd = -1;
-    UpdateState();
-    myChunk = new MPEGChunk(chunkData, chunkLength);
-    return myChunk;
-  }else{
-    return nullptr;
-  }
+MPEGChunkPtr MPEGVideoBuffer::ReadChunk(){
+  if(state != MPEG2_BUFFER_STATE_CHUNK_READY)
+    return MPEGChunkPtr();
+
+  assert(chunkStart < chunkEnd && chunkStart != -1 && chunkEnd != -1);
+  uint32_t chunkLength = chunkEnd - chunkStart;
+  auto chunkData = memory_c::slice(m_block, m_readPos + chunkStart, chunkLength);
+  m_readPos += chunkEnd;
+  m_scanPos = 0;
+  chunkStart = 0; //we read up to the next start code
+  chunkEnd = -1;
+  UpdateState();
+  return std::make_shared<MPEGChunk>(chunkData);
 }
 
 void MPEGVideoBuffer::ForceFinal(){
   if(state == MPEG2_BUFFER_STATE_NEED_MORE_DATA){
+    if(GetLength() < 4){ //Too short for a chunk
+      m_readPos = m_writePos;
+      UpdateState();
+      return;
+    }
     chunkStart = 0;
-    chunkEnd = chunkStart + myBuffer->GetLength();
+    chunkEnd = chunkStart + GetLength();
     UpdateState();
   }
 }
 
+void MPEGVideoBuffer::MakeRoom(uint32_t numBytes){
+  if((m_writePos + numBytes) <= m_capacity)
+    return;
+
+  uint32_t length = GetLength();
+
+  if(m_block.use_count() == 1){
+    memmove(m_block->get_buffer(), m_block->get_buffer() + m_readPos, length);
+
+  }else{
+    //Chunks still point into the current block. Continue with a
+    //block that isn't referenced anymore or with a new one.
+    //Surplus unreferenced blocks are released.
+    memory_cptr block;
+    auto idx = m_retiredBlocks.begin();
+    while(idx != m_retiredBlocks.end()){
+      if(idx->use_count() != 1){
+        ++idx;
+        continue;
+      }
+      if(!block)
+        block = *idx;
+      idx = m_retiredBlocks.erase(idx);
+    }
+    if(!block)
+      block = memory_c::alloc(m_capacity);
+
+    memcpy(block->get_buffer(), m_block->get_buffer() + m_readPos, length);
+    m_retiredBlocks.push_back(m_block);
+    m_block = block;
+  }
+
+  m_readPos = 0;
+  m_writePos = length;
+}
+
 int32_t MPEGVideoBuffer::Feed(binary* data, uint32_t numBytes){
-  uint32_t res = myBuffer->Write(data, numBytes);
+  if(numBytes > static_cast<uint32_t>(GetFreeBufferSpace()))
+    return -1;
+
+  MakeRoom(numBytes);
+  memcpy(m_block->get_buffer() + m_writePos, data, numBytes);
+  m_writePos += numBytes;
   UpdateState();
-  return res;
+  return 0;
 }
 
 void ParseSequenceHeader(MPEGChunk* chunk, MPEG2SequenceHeader & hdr){
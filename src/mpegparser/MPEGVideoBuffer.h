@@ -25,8 +25,8 @@
 
 #include "common/common_pch.h"
 
+#include "common/memory.h"
 #include "Types.h"
-#include "CircBuffer.h"
 
 #define MPEG_VIDEO_PICTURE_START_CODE  0x00
 #define MPEG_VIDEO_SEQUENCE_START_CODE  0xb3
@@ -82,24 +82,20 @@ struct MPEG2PictureHeader {
   MPEG2PictureHeader();
 };
 
+// A chunk's data is a slice of the video buffer's storage. It keeps
+// that storage alive for as long as the chunk exists.
 class MPEGChunk{
 private:
-  binary * data;
-  uint32_t size;
+  memory_cptr data;
   uint8_t type;
 public:
-  MPEGChunk(binary* n_data, uint32_t n_size):
-    data(n_data), size(n_size) {
+  MPEGChunk(memory_cptr const &n_data):
+    data(n_data) {
 
     assert(data);
-    assert(4 <= size);
+    assert(4 <= data->get_size());
 
-    type = data[3];
-  }
-
-  ~MPEGChunk(){
-    if(data)
-      delete [] data;
+    type = data->get_buffer()[3];
   }
 
   inline uint8_t GetType() const {
@@ -107,58 +103,62 @@ public:
   }
 
   inline uint32_t GetSize() const{
-    return size;
+    return data->get_size();
   }
 
   binary & operator[](unsigned int i){
-    return data[i];
+    return data->get_buffer()[i];
   }
 
   binary & at(unsigned int i) {
-    return data[i];
+    return data->get_buffer()[i];
   }
 
   inline binary * GetPointer(){
-    return data;
+    return data->get_buffer();
   }
 };
 
+typedef std::shared_ptr<MPEGChunk> MPEGChunkPtr;
+
 void ParseSequenceHeader(MPEGChunk* chunk, MPEG2SequenceHeader & hdr);
 bool ParsePictureHeader(MPEGChunk* chunk, MPEG2PictureHeader & hdr);
 bool ParseGOPHeader(MPEGChunk* chunk, MPEG2GOPHeader & hdr);
 
+// Linear buffer for the elementary stream. Chunks are handed out as
+// slices of the storage block without copying. Unread data is moved
+// to the front of the block when space is needed; a block that is
+// still referenced by chunks is retired instead and replaced by a free
+// one from the pool.
 class MPEGVideoBuffer{
 private:
-  CircBuffer * myBuffer;
+  memory_cptr m_block;
+  std::vector<memory_cptr> m_retiredBlocks;
+  uint32_t m_capacity;
+  uint32_t m_readPos;
+  uint32_t m_writePos;
+  uint32_t m_scanPos; //where the next start code search continues, relative to m_readPos
   MPEG2BufferState_e state;
   int32_t chunkStart;
   int32_t chunkEnd;
   void UpdateState();
+  void MakeRoom(uint32_t numBytes);
   int32_t FindStartCode(uint32_t startPos = 0);
 public:
-  MPEGVideoBuffer(uint32_t size){
-    myBuffer = new CircBuffer(size);
-    state = MPEG2_BUFFER_STATE_EMPTY;
-    chunkStart = -1;
-    chunkEnd = -1;
-  }
-
-  ~MPEGVideoBuffer(){
-    delete myBuffer;
-  }
+  MPEGVideoBuffer(uint32_t size);
 
   inline MPEG2BufferState_e GetState() const { return state; }
 
-  int32_t GetFreeBufferSpace(){
-    return (myBuffer->buf_capacity - myBuffer->bytes_in_buf);
+  inline uint32_t GetLength() const {
+    return m_writePos - m_readPos;
   }
 
-  void SetEndOfData(){
-    chunkEnd = myBuffer->GetLength() - 1;
+  int32_t GetFreeBufferSpace(){
+    return m_capacity - GetLength();
   }
 
   void ForceFinal();  //prepares the remaining data as a chunk
-  MPEGChunk * ReadChunk();
+  MPEGChunkPtr ReadChunk();
   int32_t Feed(binary* data, uint32_t numBytes);
 };
 
@@ -31,7 +31,6 @@ hevc_video_packetizer_c(generic_reader_c *p_reader,
   : video_packetizer_c(p_reader, p_ti, MKV_V_MPEGH_HEVC, fps, width, height)
   , m_nalu_size_len_src(0)
   , m_nalu_size_len_dst(0)
-  , m_max_nalu_size(0)
 {
   m_relaxed_timecode_checking = true;
 
@@ -80,8 +79,8 @@ hevc_video_packetizer_c::process(packet_cptr packet) {
 
   m_ref_timecode = packet->timecode;
 
-  if (m_nalu_size_len_dst && (m_nalu_size_len_dst != m_nalu_size_len_src))
-    change_nalu_size_len(packet);
+  if (m_nalu_transformer && !m_nalu_transformer->transform(packet->data))
+    mxerror_tid(m_ti.m_fname, m_ti.m_id, boost::format(Y("The chosen NALU size length of %1% is too small. Try using '4'.\n")) % m_nalu_size_len_dst);
 
   add_packet(packet);
 
@@ -109,83 +108,23 @@ hevc_video_packetizer_c::can_connect_to(generic_packetizer_c *src,
 
 void
 hevc_video_packetizer_c::setup_nalu_size_len_change() {
-  if (!m_ti.m_private_data || (5 > m_ti.m_private_data->get_size()))
+  // The NALU size length is stored in the lower two bits of the
+  // 22nd byte of the HEVCDecoderConfigurationRecord.
+  if (!m_ti.m_private_data || (23 > m_ti.m_private_data->get_size()))
     return;
 
   auto private_data   = m_ti.m_private_data->get_buffer();
-  m_nalu_size_len_src = (private_data[4] & 0x03) + 1;
+  m_nalu_size_len_src = (private_data[21] & 0x03) + 1;
   m_nalu_size_len_dst = m_nalu_size_len_src;
 
   if (!m_ti.m_nalu_size_length || (m_ti.m_nalu_size_length == m_nalu_size_len_src))
     return;
 
-  m_nalu_size_len_dst    = m_ti.m_nalu_size_length;
-  private_data[4]     = (private_data[4] & 0xfc) | (m_nalu_size_len_dst - 1);
-  m_max_nalu_size        = 1ll << (8 * m_nalu_size_len_dst);
+  m_nalu_size_len_dst = m_ti.m_nalu_size_length;
+  private_data[21]    = (private_data[21] & 0xfc) | (m_nalu_size_len_dst - 1);
+  m_nalu_transformer  = std::make_shared<nalu_transformer_c>(nalu_transformer_c::codec_e::hevc, m_nalu_size_len_src, m_nalu_size_len_dst);
 
   set_codec_private(m_ti.m_private_data);
 
   mxverb(2, boost::format("HEVC: Adjusting NALU size length from %1% to %2%\n") % m_nalu_size_len_src % m_nalu_size_len_dst);
 }
-
-void
-hevc_video_packetizer_c::change_nalu_size_len(packet_cptr packet) {
-  unsigned char *src = packet->data->get_buffer();
-  int size           = packet->data->get_size();
-
-  if (!src || !size)
-    return;
-
-  std::vector<int> nalu_sizes;
-
-  int src_pos = 0;
-
-  // Find all NALU sizes in this packet.
-  while (src_pos < size) {
-    if ((size - src_pos) < m_nalu_size_len_src)
-      break;
-
-    int nalu_size = 0;
-    int i;
-    for (i = 0; i < m_nalu_size_len_src; ++i)
-      nalu_size = (nalu_size << 8) + src[src_pos + i];
-
-    if ((size - src_pos - m_nalu_size_len_src) < nalu_size)
-      nalu_size = size - src_pos - m_nalu_size_len_src;
-
-    if (nalu_size > m_max_nalu_size)
-      mxerror_tid(m_ti.m_fname, m_ti.m_id, boost::format(Y("The chosen NALU size length of %1% is too small. Try using '4'.\n")) % m_nalu_size_len_dst);
-
-    src_pos += m_nalu_size_len_src + nalu_size;
-
-    nalu_sizes.push_back(nalu_size);
-  }
-
-  // Allocate memory if the new NALU size length is greater
-  // than the previous one. Otherwise reuse the existing memory.
-  if (m_nalu_size_len_dst > m_nalu_size_len_src) {
-    int new_size = size + nalu_sizes.size() * (m_nalu_size_len_dst - m_nalu_size_len_src);
-    packet->data = memory_cptr(new memory_c((unsigned char *)safemalloc(new_size), new_size, true));
-  }
-
-  // Copy the NALUs and write the new sized length field.
-  unsigned char *dst = packet->data->get_buffer();
-  src_pos            = 0;
-  int dst_pos        = 0;
-
-  size_t i;
-  for (i = 0; nalu_sizes.size() > i; ++i) {
-    int nalu_size = nalu_sizes[i];
-
-    int shift;
-    for (shift = 0; shift < m_nalu_size_len_dst; ++shift)
-      dst[dst_pos + shift] = (nalu_size >> (8 * (m_nalu_size_len_dst - 1 - shift))) & 0xff;
-
-    memmove(&dst[dst_pos + m_nalu_size_len_dst], &src[src_pos + m_nalu_size_len_src], nalu_size);
-
-    src_pos += m_nalu_size_len_src + nalu_size;
-    dst_pos += m_nalu_size_len_dst + nalu_size;
-  }
-
-  packet->data->set_size(dst_pos);
-}
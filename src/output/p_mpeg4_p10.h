@@ -16,12 +16,13 @@
 
 #include "common/common_pch.h"
 
+#include "common/nalu_transformer.h"
 #include "output/p_video.h"
 
 class mpeg4_p10_video_packetizer_c: public video_packetizer_c {
 protected:
   int m_nalu_size_len_src, m_nalu_size_len_dst;
-  int64_t m_max_nalu_size;
+  nalu_transformer_cptr m_nalu_transformer;
 
 public:
   mpeg4_p10_video_packetizer_c(generic_reader_c *p_reader, track_info_c &p_ti, double fps, int width, int height);
@@ -37,8 +38,6 @@ public:
 protected:
   virtual void extract_aspect_ratio();
   virtual void setup_nalu_size_len_change();
-  virtual void change_nalu_size_len(packet_cptr packet);
-  virtual void remove_filler_nalus(memory_c &data) const;
 };
 
 #endif  // MTX_P_MPEG4_P10_H
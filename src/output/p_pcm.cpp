@@ -88,15 +88,40 @@ pcm_packetizer_c::process(packet_cptr packet) {
   if (packet->has_timecode() && (packet->data->get_size() >= m_min_packet_size))
     return process_packaged(packet);
 
-  m_buffer.add(packet->data->get_buffer(), packet->data->get_size());
+  auto data      = packet->data->get_buffer();
+  auto size      = packet->data->get_size();
+  auto offset    = size_t{};
+  auto remaining = m_buffer.get_size();
+
+  // Complete a packet started by previous input first. Only that
+  // packet has to be copied.
+  if (remaining) {
+    auto to_copy = std::min(m_packet_size - remaining, size);
+
+    m_buffer.add(data, to_copy);
+    offset += to_copy;
+
+    if (m_buffer.get_size() < m_packet_size)
+      return FILE_STATUS_MOREDATA;
 
-  while (m_buffer.get_size() >= m_packet_size) {
     add_packet(new packet_t(memory_c::clone(m_buffer.get_buffer(), m_packet_size), m_samples_output * m_s2tc, m_samples_per_packet * m_s2tc));
 
     m_buffer.remove(m_packet_size);
     m_samples_output += m_samples_per_packet;
   }
 
+  // All complete packets in the input can refer to the input's memory
+  // directly.
+  while ((size - offset) >= m_packet_size) {
+    add_packet(new packet_t(memory_c::slice(packet->data, offset, m_packet_size), m_samples_output * m_s2tc, m_samples_per_packet * m_s2tc));
+
+    offset           += m_packet_size;
+    m_samples_output += m_samples_per_packet;
+  }
+
+  if (offset < size)
+    m_buffer.add(&data[offset], size - offset);
+
   return FILE_STATUS_MOREDATA;
 }
 
@@ -16,6 +16,8 @@
 #include <matroska/KaxTracks.h>
 
 #include "common/codec.h"
+#include "common/hacks.h"
+#include "common/text_subtitles.h"
 #include "merge/connection_checks.h"
 #include "merge/packet_extensions.h"
 #include "output/p_textsubs.h"
@@ -69,16 +71,22 @@ textsubs_packetizer_c::process(packet_cptr packet) {
 
   packet->duration_mandatory = true;
 
-  auto subs = std::string{reinterpret_cast<char *>(packet->data->get_buffer()), packet->data->get_size()};
+  auto &subs = m_subs;
 
-  subs = boost::regex_replace(subs, s_re_remove_cr,          "",     boost::match_default | boost::match_single_line);
-  subs = boost::regex_replace(subs, s_re_remove_trailing_nl, "",     boost::match_default | boost::match_single_line);
-  subs = boost::regex_replace(subs, s_re_translate_nl,       "\r\n", boost::match_default | boost::match_single_line);
+  if (hack_engaged(ENGAGE_REGEX_TEXT_SUBTITLE_PARSERS)) {
+    subs = std::string{reinterpret_cast<char *>(packet->data->get_buffer()), packet->data->get_size()};
+
+    subs = boost::regex_replace(subs, s_re_remove_cr,          "",     boost::match_default | boost::match_single_line);
+    subs = boost::regex_replace(subs, s_re_remove_trailing_nl, "",     boost::match_default | boost::match_single_line);
+    subs = boost::regex_replace(subs, s_re_translate_nl,       "\r\n", boost::match_default | boost::match_single_line);
+
+  } else
+    mtx::text_subtitles::normalize_line_endings(reinterpret_cast<char const *>(packet->data->get_buffer()), packet->data->get_size(), subs);
 
   if (m_recode)
     subs = m_cc_utf8->utf8(subs);
 
-  packet->data = memory_cptr(new memory_c((unsigned char *)subs.c_str(), subs.length(), false));
+  packet->data = memory_c::clone(subs);
 
   add_packet(packet);
 
@@ -24,6 +24,7 @@ private:
   charset_converter_cptr m_cc_utf8;
   std::string m_codec_id;
   bool m_recode;
+  std::string m_subs;
 
 public:
   textsubs_packetizer_c(generic_reader_c *p_reader, track_info_c &p_ti, const char *codec_id, bool recode, bool is_utf8);
@@ -79,7 +79,7 @@ int
 truehd_packetizer_c::process(packet_cptr packet) {
   m_timecode_calculator.add_timecode(packet);
 
-  m_parser.add_data(packet->data->get_buffer(), packet->data->get_size());
+  m_parser.add_bytes(packet->data);
 
   flush_frames();
 
@@ -0,0 +1,33 @@
+#!/usr/bin/ruby -w
+
+require "json"
+
+# T_495server_mode_identification
+describe "mkvmerge / several identification requests in one server mode session"
+
+# The result consists of each response's ID, exit code, whether or not
+# there's output and the number of errors instead of a checksum so
+# that it only depends on the server surviving all requests. The
+# first and the last request identify the same file and must yield the
+# same output.
+test "identification" do
+  requests = [
+    %q{{"id":"1","action":"identify","file":"data/avi/v.avi"}},
+    %q{{"id":"2","action":"identify","file":"data/wav/wmav2.wav"}},
+    %q{{"id":"3","action":"identify","file":"data/aac/aac_adif.aac","mode":"verbose"}},
+    %q{{"id":"4","action":"identify","file":"data/simple/v.mp3","mode":"mmg"}},
+    %q{{"id":"5","action":"identify","file":"data/does-not-exist.avi"}},
+    %q{{"id":"6","action":"identify","file":"data/avi/v.avi"}},
+  ]
+
+  File.open("#{tmp}-requests", "w") { |file| file.puts requests.join("\n") }
+
+  sys "../src/mkvmerge --server < #{tmp}-requests > #{tmp}"
+  File.unlink "#{tmp}-requests"
+
+  responses = IO.readlines(tmp).collect { |line| JSON.parse(line) }
+  result    = responses.collect { |response| [ response["id"], response["exit_code"], response["output"].empty? ? 0 : 1, response["errors"].size ].join(".") }
+  result   << (responses.first["output"] == responses.last["output"] ? "same" : "different")
+
+  result.join "+"
+end
@@ -1,5 +1,8 @@
 #include "common/common_pch.h"
 
+#include <chrono>
+#include <random>
+
 #include "common/bit_cursor.h"
 #include "common/endian.h"
 
@@ -303,4 +306,181 @@ TEST(BitReader, ExceptionOnReadingBeyondEOF) {
   EXPECT_THROW(b.get_bytes(target, 2), mtx::mm_io::end_of_file_x);
 }
 
+TEST(BitReader, GetUnsignedGolombNearEOF) {
+  unsigned char value[2];
+
+  // 0000 0000 0001 0110 = 11 leading zeros, not enough bits left
+  put_uint16_be(value, 0x0016);
+  auto b = bit_reader_c{value, 2};
+  EXPECT_THROW(b.get_unsigned_golomb(), mtx::mm_io::end_of_file_x);
+  EXPECT_TRUE(b.eof());
+
+  // 0000 0001 0110 0001 = 7 leading zeros, code ends at the last bit
+  put_uint16_be(value, 0x0161);
+  b = bit_reader_c{value, 2};
+  EXPECT_EQ(175, b.get_unsigned_golomb());
+  EXPECT_EQ(15, b.get_bit_position());
+  EXPECT_EQ(1, b.get_bit());
+  EXPECT_FALSE(b.eof());
+}
+
+TEST(BitReader, GetBitsWide) {
+  unsigned char value[9];
+  put_uint64_be(value, 0x0123456789abcdefull);
+  value[8] = 0xa5;
+  auto b = bit_reader_c{value, 9};
+
+  EXPECT_EQ(0x0123456789abcdefull, b.peek_bits(64));
+  EXPECT_EQ(0x0123456789abcdefull >> 1, b.get_bits(63));
+  EXPECT_EQ(0x1a5u, b.get_bits(9));
+  EXPECT_THROW(b.get_bits(1), mtx::mm_io::end_of_file_x);
+}
+
+// Runs the same random sequence of operations on both readers.
+TEST(BitReader, SameResultsAsBytewiseReader) {
+  std::mt19937 rng{4711};
+  std::vector<unsigned char> data(257);
+
+  for (auto round = 0; round < 200; ++round) {
+    // Few set bits result in long Exp-Golomb codes. Runs of zero bits
+    // are limited to 30 as longer codes overflow an int.
+    for (auto &byte : data)
+      byte = rng() & (round & 1 ? 0xff : rng() & rng());
+
+    for (auto bit = 0u, num_zeros = 0u; bit < (data.size() * 8); ++bit)
+      if (data[bit / 8] & (0x80 >> (bit % 8)))
+        num_zeros = 0;
+      else if (++num_zeros == 30) {
+        data[bit / 8] |= 0x80 >> (bit % 8);
+        num_zeros      = 0;
+      }
+
+    auto size      = 1 + rng() % data.size();
+    auto fast      = bit_reader_c{&data[0], size};
+    auto reference = bytewise_bit_reader_c{&data[0], size};
+
+    for (auto done = false; !done;) {
+      auto operation = rng() % 6;
+      auto num_bits  = rng() % 65;
+      int64_t fast_result{}, reference_result{};
+      bool fast_threw{}, reference_threw{};
+
+      try {
+        fast_result = 0 == operation ? fast.get_bits(num_bits)
+                    : 1 == operation ? fast.peek_bits(num_bits)
+                    : 2 == operation ? fast.get_unsigned_golomb()
+                    : 3 == operation ? fast.get_signed_golomb()
+                    : 4 == operation ? fast.get_bit()
+                    :                  (fast.skip_bits(num_bits % 17), 0);
+      } catch (mtx::mm_io::end_of_file_x &) {
+        fast_threw = true;
+      }
+
+      try {
+        reference_result = 0 == operation ? reference.get_bits(num_bits)
+                         : 1 == operation ? reference.peek_bits(num_bits)
+                         : 2 == operation ? reference.get_unsigned_golomb()
+                         : 3 == operation ? reference.get_signed_golomb()
+                         : 4 == operation ? reference.get_bit()
+                         :                  (reference.skip_bits(num_bits % 17), 0);
+      } catch (mtx::mm_io::end_of_file_x &) {
+        reference_threw = true;
+      }
+
+      ASSERT_EQ(reference_threw, fast_threw);
+      ASSERT_EQ(reference.eof(),  fast.eof());
+
+      if (reference_threw)
+        done = true;
+      else {
+        ASSERT_EQ(reference_result,               fast_result);
+        ASSERT_EQ(reference.get_bit_position(),   fast.get_bit_position());
+        ASSERT_EQ(reference.get_remaining_bits(), fast.get_remaining_bits());
+      }
+    }
+  }
+}
+
+// Microbenchmarks comparing bit_reader_c with the bytewise reader. They
+// are disabled by default; run them with
+// "--gtest_also_run_disabled_tests --gtest_filter=*Benchmark*".
+
+template<typename Treader, typename Tfunction>
+double
+benchmark(std::vector<unsigned char> const &data,
+          Tfunction const &function) {
+  auto start  = std::chrono::steady_clock::now();
+  auto result = uint64_t{};
+
+  for (auto round = 0; round < 200; ++round) {
+    auto reader = Treader{&data[0], data.size()};
+    try {
+      while (true)
+        result += function(reader);
+    } catch (mtx::mm_io::end_of_file_x &) {
+    }
+  }
+
+  auto duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  EXPECT_NE(0u, result);
+
+  return duration;
+}
+
+template<typename Tfunction>
+void
+compare_readers(char const *name) {
+  Tfunction function;
+  std::mt19937 rng{42};
+  std::vector<unsigned char> data(64 * 1024);
+  for (auto &byte : data)
+    byte = rng();
+
+  auto reference = benchmark<bytewise_bit_reader_c>(data, function);
+  auto fast      = benchmark<bit_reader_c>(data, function);
+
+  std::cout << (boost::format("%1%: bytewise %|2$.1f| ms, 64-bit words %|3$.1f| ms, speedup %|4$.2f|\n") % name % reference % fast % (reference / fast));
+}
+
+struct get_bits_t {
+  template<typename Treader> uint64_t operator ()(Treader &reader) const {
+    return reader.get_bits(1 + (reader.get_bit_position() % 32));
+  }
+};
+
+struct get_bit_t {
+  template<typename Treader> uint64_t operator ()(Treader &reader) const {
+    return reader.get_bit();
+  }
+};
+
+struct get_unsigned_golomb_t {
+  template<typename Treader> uint64_t operator ()(Treader &reader) const {
+    return reader.get_unsigned_golomb();
+  }
+};
+
+struct skip_bits_t {
+  template<typename Treader> uint64_t operator ()(Treader &reader) const {
+    reader.skip_bits(13);
+    return reader.get_bits(8);
+  }
+};
+
+TEST(BitReader, DISABLED_BenchmarkGetBits) {
+  compare_readers<get_bits_t>("get_bits(1..32)");
+}
+
+TEST(BitReader, DISABLED_BenchmarkGetBit) {
+  compare_readers<get_bit_t>("get_bit");
+}
+
+TEST(BitReader, DISABLED_BenchmarkGetUnsignedGolomb) {
+  compare_readers<get_unsigned_golomb_t>("get_unsigned_golomb");
+}
+
+TEST(BitReader, DISABLED_BenchmarkSkipBits) {
+  compare_readers<skip_bits_t>("skip_bits + get_bits(8)");
+}
+
 }
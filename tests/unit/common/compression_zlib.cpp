@@ -0,0 +1,79 @@
+#include "common/common_pch.h"
+
+#include "gtest/gtest.h"
+
+#include "common/compression.h"
+
+namespace {
+
+std::string
+make_packet(size_t size,
+            unsigned int seed) {
+  std::string packet(size, '\0');
+
+  for (auto idx = 0u; idx < size; ++idx)
+    packet[idx] = static_cast<char>(((idx / 16) * seed) & 0xff);
+
+  return packet;
+}
+
+TEST(CompressionZlib, RoundTripReusingOneCompressor) {
+  // The streams are re-used for each packet, and the decompression
+  // buffer starts at the previous packet's size. Vary the sizes so that
+  // both growing and shrinking output sizes are covered. The 200000
+  // byte packet compresses to far less than a quarter of its size.
+  auto sizes      = std::vector<size_t>{ 1, 100, 200000, 10, 0, 65536, 3 };
+  auto compressor = std::make_shared<zlib_compressor_c>();
+  auto other      = std::make_shared<zlib_compressor_c>();
+  auto seed       = 1u;
+
+  for (auto size : sizes) {
+    auto packet     = make_packet(size, seed++);
+    auto compressed = compressor->compress(memory_c::clone(packet));
+
+    ASSERT_TRUE(!!compressed);
+
+    auto decompressed = compressor->decompress(compressed->clone());
+    EXPECT_EQ(packet, std::string(reinterpret_cast<char const *>(decompressed->get_buffer()), decompressed->get_size()));
+
+    decompressed = other->decompress(compressed);
+    EXPECT_EQ(packet, std::string(reinterpret_cast<char const *>(decompressed->get_buffer()), decompressed->get_size()));
+  }
+}
+
+TEST(CompressionZlib, RoundTripStrings) {
+  auto compressor = std::make_shared<zlib_compressor_c>();
+
+  for (auto const &packet : std::vector<std::string>{ "Hello world", std::string(10000, 'x'), "42" })
+    EXPECT_EQ(packet, compressor->decompress(compressor->compress(packet)));
+}
+
+TEST(CompressionZlib, CompressionLevel) {
+  auto packet     = make_packet(100000, 3);
+  auto compressor = std::make_shared<zlib_compressor_c>(Z_NO_COMPRESSION);
+  auto stored     = compressor->compress(packet);
+
+  EXPECT_GT(stored.size(), packet.size());
+  EXPECT_EQ(packet, compressor->decompress(stored));
+
+  // Changing the level must take effect on a stream that has already
+  // been used.
+  compressor->set_compression_level(Z_BEST_COMPRESSION);
+  auto compressed = compressor->compress(packet);
+
+  EXPECT_LT(compressed.size(), packet.size() / 10);
+  EXPECT_EQ(packet, compressor->decompress(compressed));
+  EXPECT_EQ(compressed, zlib_compressor_c{}.compress(packet));
+}
+
+TEST(CompressionZlib, InvalidData) {
+  auto compressor = std::make_shared<zlib_compressor_c>();
+
+  EXPECT_THROW(compressor->decompress(memory_c::clone(std::string{"not zlib compressed"})), mtx::compression_x);
+
+  // The stream must be usable again after a failure.
+  auto packet = make_packet(1000, 7);
+  EXPECT_EQ(packet, compressor->decompress(compressor->compress(packet)));
+}
+
+}
@@ -0,0 +1,66 @@
+#include "common/common_pch.h"
+
+#include "gtest/gtest.h"
+
+#include "common/frame_sync_parser.h"
+
+namespace {
+
+std::string
+to_string(memory_cptr const &mem) {
+  return std::string(reinterpret_cast<char const *>(mem->get_buffer()), mem->get_size());
+}
+
+TEST(FrameSyncParser, FindSyncWord) {
+  unsigned char const buffer[] = { 0x00, 0x0b, 0x00, 0x0b, 0x77, 0xff, 0xf1, 0x0b };
+
+  EXPECT_EQ(3u, mtx::frame_sync::find_sync_word(buffer, sizeof(buffer), 0x0b, 0x77));
+  EXPECT_EQ(5u, mtx::frame_sync::find_sync_word(buffer, sizeof(buffer), 0xff, 0xf0, 0xf0));
+  EXPECT_EQ(sizeof(buffer), mtx::frame_sync::find_sync_word(buffer, sizeof(buffer), 0xff, 0xe0));
+
+  // A first byte at the very end cannot be followed by a second one.
+  EXPECT_EQ(3u,             mtx::frame_sync::find_sync_word(buffer + 5, 3, 0x0b, 0x00, 0x00));
+  EXPECT_EQ(0u,             mtx::frame_sync::find_sync_word(buffer, 0, 0x0b, 0x77));
+}
+
+TEST(FrameSyncParser, BufferReferencesOwnedMemory) {
+  frame_sync_buffer_c buffer;
+  auto input = memory_c::clone(std::string{"0123456789"});
+
+  buffer.add(input);
+
+  EXPECT_EQ(input->get_buffer(), buffer.get_buffer());
+  EXPECT_EQ(10u, buffer.get_size());
+
+  auto frame = buffer.get_frame_data(2, 4);
+  EXPECT_EQ(input->get_buffer() + 2, frame->get_buffer());
+  EXPECT_EQ(std::string{"2345"}, to_string(frame));
+
+  // The unparsed rest is copied once the referenced data is removed.
+  buffer.remove(6);
+  input.reset();
+
+  EXPECT_EQ(4u, buffer.get_size());
+  EXPECT_EQ(std::string{"6789"}, std::string(reinterpret_cast<char const *>(buffer.get_buffer()), buffer.get_size()));
+  EXPECT_EQ(std::string{"2345"}, to_string(frame));
+}
+
+TEST(FrameSyncParser, BufferCopiesUnownedMemoryAndLeftovers) {
+  frame_sync_buffer_c buffer;
+  std::string content{"abcdef"};
+
+  buffer.add(memory_c::point_to(content));
+  EXPECT_NE(reinterpret_cast<unsigned char *>(&content[0]), buffer.get_buffer());
+
+  // Bytes left over must stay in front of new data.
+  buffer.add(memory_c::clone(std::string{"gh"}));
+  EXPECT_EQ(8u, buffer.get_size());
+
+  auto frame = buffer.get_frame_data(4, 4);
+  buffer.remove(8);
+
+  EXPECT_EQ(0u, buffer.get_size());
+  EXPECT_EQ(std::string{"efgh"}, to_string(frame));
+}
+
+}
@@ -21,6 +21,15 @@ TEST(Math, Popcount) {
   EXPECT_EQ(63, mtx::math::count_1_bits(std::numeric_limits<uint64_t>::max() - 1));
 }
 
+TEST(Math, CountLeadingZeroBits) {
+  EXPECT_EQ(64, mtx::math::count_leading_zero_bits(0));
+  EXPECT_EQ(63, mtx::math::count_leading_zero_bits(1));
+  EXPECT_EQ(56, mtx::math::count_leading_zero_bits(0xffu));
+  EXPECT_EQ(32, mtx::math::count_leading_zero_bits(0x80000000ul));
+  EXPECT_EQ( 0, mtx::math::count_leading_zero_bits(0x8000000000000000ull));
+  EXPECT_EQ( 0, mtx::math::count_leading_zero_bits(std::numeric_limits<uint64_t>::max()));
+}
+
 TEST(Math, IntLog2) {
   EXPECT_EQ(-1, mtx::math::int_log2(0));
   EXPECT_EQ(0, mtx::math::int_log2(1));
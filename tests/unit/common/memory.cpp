@@ -0,0 +1,52 @@
+#include "common/common_pch.h"
+
+#include "gtest/gtest.h"
+
+#include "common/memory.h"
+
+namespace {
+
+TEST(Memory, Slice) {
+  auto parent = memory_c::clone(std::string{"0123456789"});
+  auto slice  = memory_c::slice(parent, 2, 5);
+
+  EXPECT_EQ(5u, slice->get_size());
+  EXPECT_EQ(parent->get_buffer() + 2, slice->get_buffer());
+  EXPECT_EQ(std::string{"23456"}, std::string(reinterpret_cast<char const *>(slice->get_buffer()), slice->get_size()));
+
+  // The slice keeps its parent's memory alive and is treated as owned
+  // memory.
+  auto buffer = slice->get_buffer();
+  parent.reset();
+  slice->grab();
+
+  EXPECT_EQ(buffer, slice->get_buffer());
+  EXPECT_EQ(std::string{"23456"}, std::string(reinterpret_cast<char const *>(slice->get_buffer()), slice->get_size()));
+}
+
+TEST(Memory, SliceOfUnownedMemory) {
+  std::string content{"0123456789"};
+  auto parent = memory_c::point_to(content);
+  auto slice  = memory_c::slice(parent, 4, 3);
+
+  EXPECT_TRUE(parent->is_free());
+  EXPECT_NE(reinterpret_cast<unsigned char *>(&content[4]), slice->get_buffer());
+
+  content = "xxxxxxxxxx";
+
+  EXPECT_EQ(std::string{"456"}, std::string(reinterpret_cast<char const *>(slice->get_buffer()), slice->get_size()));
+}
+
+TEST(Memory, ResizeSlice) {
+  auto parent = memory_c::clone(std::string{"0123456789"});
+  auto slice  = memory_c::slice(parent, 8, 2);
+
+  slice->resize(4);
+
+  EXPECT_TRUE(slice->is_free());
+  EXPECT_EQ(4u, slice->get_size());
+  EXPECT_EQ(std::string{"89"}, std::string(reinterpret_cast<char const *>(slice->get_buffer()), 2));
+  EXPECT_EQ(std::string{"0123456789"}, std::string(reinterpret_cast<char const *>(parent->get_buffer()), parent->get_size()));
+}
+
+}
@@ -4,6 +4,7 @@
 #include "tests/unit/util.h"
 
 #include "common/mm_io_x.h"
+#include "common/mm_write_buffer_io.h"
 
 namespace {
 
@@ -16,4 +17,46 @@ TEST(MmIo, Slurp) {
   ASSERT_THROW(mm_file_io_c::slurp("doesnotexist"), mtx::mm_io::exception);
 }
 
+TEST(MmIo, TextIoGetlineUtf8) {
+  auto data = std::string{"\xef\xbb\xbf" "Chunky\r\nBacon \xc3\xa4\r\n\r\nend"};
+  mm_text_io_c in(new mm_mem_io_c(reinterpret_cast<unsigned char const *>(data.c_str()), data.length()));
+
+  EXPECT_EQ(BO_UTF8, in.get_byte_order());
+  EXPECT_EQ(std::string{"Chunky"},           in.getline());
+  EXPECT_EQ(11u,                             in.getFilePointer());
+  EXPECT_EQ(std::string{"Bacon \xc3\xa4"},   in.getline());
+  EXPECT_EQ(std::string{""},                 in.getline());
+  EXPECT_EQ(std::string{"end"},              in.getline());
+  EXPECT_TRUE(in.eof());
+  EXPECT_THROW(in.getline(), mtx::mm_io::end_of_file_x);
+
+  in.setFilePointer(0);
+  EXPECT_EQ(std::string{"Chunky"},           in.getline());
+}
+
+TEST(MmIo, TextIoGetlineUtf16) {
+  auto data = std::string{"\xff\xfe" "a\0\xe4\0\n\0" "b\0\xac\x20\n\0", 14};
+  mm_text_io_c in(new mm_mem_io_c(reinterpret_cast<unsigned char const *>(data.c_str()), data.length()));
+
+  EXPECT_EQ(BO_UTF16_LE, in.get_byte_order());
+  EXPECT_EQ(std::string{"a\xc3\xa4"},        in.getline());
+  EXPECT_EQ(8u,                              in.getFilePointer());
+  EXPECT_EQ(std::string{"b\xe2\x82\xac"},    in.getline());
+}
+
+TEST(MmIo, WriteBufferWritev) {
+  mm_mem_io_c mem_io{nullptr, 0, 100};
+  mm_write_buffer_io_c out{&mem_io, 8, false};
+
+  auto vectors = mm_io_vecs_t{ { "abc", 3 }, { "defghij", 7 }, { "k", 1 } };
+
+  EXPECT_EQ(11u, out.writev(vectors));
+  EXPECT_EQ(11u, out.getFilePointer());
+  EXPECT_EQ(8u,  mem_io.getFilePointer());
+
+  out.flush();
+
+  EXPECT_EQ(std::string{"abcdefghijk"}, std::string(reinterpret_cast<char const *>(mem_io.get_buffer()), mem_io.get_size()));
+}
+
 }
@@ -0,0 +1,78 @@
+#include "common/common_pch.h"
+
+#include "gtest/gtest.h"
+
+#include "common/hevc.h"
+#include "common/mpeg4_p10.h"
+#include "common/nalu_transformer.h"
+
+namespace {
+
+std::string
+transform(nalu_transformer_c const &transformer,
+          std::string const &frame,
+          bool expected_result = true) {
+  auto data = memory_c::clone(frame);
+  EXPECT_EQ(expected_result, transformer.transform(data));
+
+  return std::string{reinterpret_cast<char const *>(data->get_buffer()), data->get_size()};
+}
+
+// Three NALUs with four-byte length fields: a slice, filler data and
+// an access unit delimiter.
+std::string const s_frame{"\x00\x00\x00\x02\x65\x01" "\x00\x00\x00\x02\x0c\xff" "\x00\x00\x00\x01\x09", 17};
+
+TEST(NaluTransformer, DropTypes) {
+  nalu_transformer_c transformer{nalu_transformer_c::codec_e::avc, 4, 4};
+  EXPECT_EQ(s_frame, transform(transformer, s_frame));
+
+  transformer.drop_type(NALU_TYPE_FILLER_DATA);
+  transformer.drop_type(NALU_TYPE_ACCESS_UNIT);
+  EXPECT_EQ(std::string("\x00\x00\x00\x02\x65\x01", 6), transform(transformer, s_frame));
+}
+
+TEST(NaluTransformer, ShrinkSizeLength) {
+  nalu_transformer_c transformer{nalu_transformer_c::codec_e::avc, 4, 2};
+  transformer.drop_type(NALU_TYPE_FILLER_DATA);
+
+  EXPECT_EQ(std::string("\x00\x02\x65\x01" "\x00\x01\x09", 7), transform(transformer, s_frame));
+}
+
+TEST(NaluTransformer, GrowSizeLength) {
+  nalu_transformer_c transformer{nalu_transformer_c::codec_e::avc, 2, 4};
+  transformer.drop_type(NALU_TYPE_FILLER_DATA);
+
+  EXPECT_EQ(std::string("\x00\x00\x00\x02\x65\x01" "\x00\x00\x00\x01\x09", 11), transform(transformer, std::string("\x00\x02\x65\x01" "\x00\x02\x0c\xff" "\x00\x01\x09", 11)));
+}
+
+TEST(NaluTransformer, TruncatedFrames) {
+  nalu_transformer_c transformer{nalu_transformer_c::codec_e::avc, 4, 2};
+
+  EXPECT_EQ(std::string("\x00\x01\x65", 3), transform(transformer, std::string("\x00\x00\x00\x08\x65", 5)));
+  EXPECT_EQ(std::string("\x00\x01\x65", 3), transform(transformer, std::string("\x00\x00\x00\x01\x65\x00\x00", 7)));
+}
+
+TEST(NaluTransformer, BrokenDataKeptWithoutSizeLengthChange) {
+  nalu_transformer_c transformer{nalu_transformer_c::codec_e::avc, 4, 4};
+  transformer.drop_type(NALU_TYPE_FILLER_DATA);
+
+  EXPECT_EQ(std::string("\x00\x00\x00\x08\x65", 5), transform(transformer, std::string("\x00\x00\x00\x08\x65", 5)));
+  EXPECT_EQ(std::string("\x00\x00\x00\x01\x65\x00\x00", 7), transform(transformer, std::string("\x00\x00\x00\x01\x65\x00\x00", 7)));
+  EXPECT_EQ(std::string("\x00\x00\x00\x01\x65" "\x00\x00\x00\x09\x0c", 10), transform(transformer, std::string("\x00\x00\x00\x02\x0c\xff" "\x00\x00\x00\x01\x65" "\x00\x00\x00\x09\x0c", 16)));
+}
+
+TEST(NaluTransformer, SizeLengthTooSmall) {
+  nalu_transformer_c transformer{nalu_transformer_c::codec_e::avc, 4, 1};
+
+  transform(transformer, std::string("\x00\x00\x00\xff", 4) + std::string(255, '\x65'));
+  transform(transformer, std::string("\x00\x00\x01\x00", 4) + std::string(256, '\x65'), false);
+}
+
+TEST(NaluTransformer, HevcNaluTypes) {
+  nalu_transformer_c transformer{nalu_transformer_c::codec_e::hevc, 4, 4};
+  transformer.drop_type(HEVC_NALU_TYPE_FILLER_DATA);
+
+  EXPECT_EQ(std::string("\x00\x00\x00\x02\x26\x01", 6), transform(transformer, std::string("\x00\x00\x00\x02\x4c\x01" "\x00\x00\x00\x02\x26\x01", 12)));
+}
+
+}
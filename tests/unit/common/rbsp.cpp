@@ -0,0 +1,48 @@
+#include "common/common_pch.h"
+
+#include "gtest/gtest.h"
+
+#include "common/rbsp.h"
+
+namespace {
+
+std::string
+to_string(memory_cptr const &mem) {
+  return std::string{reinterpret_cast<char const *>(mem->get_buffer()), mem->get_size()};
+}
+
+std::string const s_nalu{"\x65\x00\x00\x03\x01\x00\x00\x03\x00\x00\x03\x03", 12};
+std::string const s_rbsp{"\x65\x00\x00\x01\x00\x00\x00\x00\x03", 9};
+
+TEST(Rbsp, NaluToRbsp) {
+  EXPECT_EQ(s_rbsp, to_string(mtx::rbsp::nalu_to_rbsp(memory_c::clone(s_nalu))));
+}
+
+TEST(Rbsp, RbspToNalu) {
+  EXPECT_EQ(s_nalu, to_string(mtx::rbsp::rbsp_to_nalu(memory_c::clone(s_rbsp))));
+
+  auto zeros = memory_c::clone(std::string(5, '\0'));
+  EXPECT_EQ(std::string("\x00\x00\x03\x00\x00\x03\x00", 7), to_string(mtx::rbsp::rbsp_to_nalu(zeros)));
+}
+
+TEST(Rbsp, UnchangedBuffersAreNotCopied) {
+  auto nalu = memory_c::clone(std::string{"\x65\x00\x00\x04\x03\x00\x00", 7});
+
+  EXPECT_EQ(nalu, mtx::rbsp::nalu_to_rbsp(nalu));
+  EXPECT_EQ(nalu, mtx::rbsp::rbsp_to_nalu(nalu));
+}
+
+TEST(Rbsp, BoundedConversion) {
+  unsigned char buffer[8];
+
+  auto nalu = reinterpret_cast<unsigned char const *>(s_nalu.data());
+
+  EXPECT_EQ(8u, mtx::rbsp::nalu_to_rbsp(nalu, s_nalu.size(), buffer, sizeof(buffer)));
+  EXPECT_EQ(s_rbsp.substr(0, 8), std::string(reinterpret_cast<char const *>(buffer), 8));
+
+  // The emulation prevention byte at the end of the source is removed.
+  EXPECT_EQ(3u, mtx::rbsp::nalu_to_rbsp(nalu, 4, buffer, sizeof(buffer)));
+  EXPECT_EQ(0u, mtx::rbsp::nalu_to_rbsp(nalu, 4, buffer, 0));
+}
+
+}
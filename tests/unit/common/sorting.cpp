@@ -0,0 +1,39 @@
+#include "common/common_pch.h"
+
+#include "common/sorting.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+TEST(Sorting, NearlySorted) {
+  auto values = std::vector<int>{ 0, 3, 1, 2, 6, 4, 5, 8, 7 };
+  mtx::sort::nearly_sorted(values.begin(), values.end());
+  EXPECT_EQ((std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8 }), values);
+
+  values = std::vector<int>{ 5, 4, 3, 2, 1 };
+  mtx::sort::nearly_sorted(values.begin(), values.end());
+  EXPECT_EQ((std::vector<int>{ 1, 2, 3, 4, 5 }), values);
+
+  values.clear();
+  mtx::sort::nearly_sorted(values.begin(), values.end());
+  EXPECT_TRUE(values.empty());
+}
+
+TEST(Sorting, NearlySortedIsStable) {
+  auto values = std::vector<std::pair<int, int>>{ { 2, 0 }, { 1, 1 }, { 2, 2 }, { 1, 3 } };
+  mtx::sort::nearly_sorted(values.begin(), values.end(), [](std::pair<int, int> const &a, std::pair<int, int> const &b) { return a.first < b.first; });
+
+  EXPECT_EQ((std::vector<std::pair<int, int>>{ { 1, 1 }, { 1, 3 }, { 2, 0 }, { 2, 2 } }), values);
+}
+
+TEST(Sorting, InsertNearlySorted) {
+  std::deque<int64_t> values;
+
+  for (auto value : std::vector<int64_t>{ 40, 0, 20, 10, 30, 80, 60, 50, 70, 0 })
+    mtx::sort::insert_nearly_sorted(values, value);
+
+  EXPECT_EQ((std::deque<int64_t>{ 0, 0, 10, 20, 30, 40, 50, 60, 70, 80 }), values);
+}
+
+}
@@ -0,0 +1,111 @@
+#include "common/common_pch.h"
+
+#include "common/text_subtitles.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace mtx::text_subtitles;
+
+TEST(TextSubtitles, SrtNumber) {
+  EXPECT_TRUE(is_srt_number("1"));
+  EXPECT_TRUE(is_srt_number("0815"));
+
+  EXPECT_FALSE(is_srt_number(""));
+  EXPECT_FALSE(is_srt_number(" 1"));
+  EXPECT_FALSE(is_srt_number("1a"));
+}
+
+TEST(TextSubtitles, SrtTimecodeLine) {
+  int64_t start = 0, end = 0;
+
+  EXPECT_TRUE(parse_srt_timecode_line("00:00:01,500 --> 00:01:02,250", start, end));
+  EXPECT_EQ(1500000000ll,  start);
+  EXPECT_EQ(62250000000ll, end);
+
+  EXPECT_TRUE(parse_srt_timecode_line("1:2:3.4->1:2:3:1234567891 X1:2 Y3:4", start, end));
+  EXPECT_EQ(3723400000000ll, start);
+  EXPECT_EQ(3723123456789ll, end);
+
+  EXPECT_TRUE(parse_srt_timecode_line(" - 00: 00: 01, 5 - - > 00:00:02,000", start, end));
+  EXPECT_EQ(-1000000000ll + 500000000ll, start);
+  EXPECT_EQ(2000000000ll, end);
+
+  EXPECT_FALSE(parse_srt_timecode_line("", start, end));
+  EXPECT_FALSE(parse_srt_timecode_line("00:00:01,500", start, end));
+  EXPECT_FALSE(parse_srt_timecode_line("00:00:01,500> 00:00:02,000", start, end));
+  EXPECT_FALSE(parse_srt_timecode_line("00:00:01,500 --> 00:00:02", start, end));
+  EXPECT_FALSE(parse_srt_timecode_line("00:00,01,500 --> 00:00:02,000", start, end));
+  EXPECT_FALSE(parse_srt_timecode_line("Hello --> 00:00:02,000", start, end));
+}
+
+TEST(TextSubtitles, SrtCoordinates) {
+  EXPECT_TRUE(has_srt_coordinates("00:00:01,500 --> 00:00:02,000 X1:100 X2:200 Y1:10 Y2:20"));
+  EXPECT_TRUE(has_srt_coordinates("00:00:01,500 --> 00:00:02,000X1:100X2:200Y1:10Y2:20  "));
+
+  EXPECT_FALSE(has_srt_coordinates("00:00:01,500 --> 00:00:02,000"));
+  EXPECT_FALSE(has_srt_coordinates("00:00:01,500 --> 00:00:02,000 X1:100 X2:200 Y1:10"));
+  EXPECT_FALSE(has_srt_coordinates("00:00:01,500 --> 00:00:02,000 X1:100 X2:200 Y1:10 Y2:20 Z"));
+  EXPECT_FALSE(has_srt_coordinates("00:00:01,500 --> 00:00:02,000 X1:100 X2:200 Y1:10 Y2:"));
+}
+
+TEST(TextSubtitles, SsaSection) {
+  EXPECT_TRUE(is_ssa_section("[Script Info]",           "script info"));
+  EXPECT_TRUE(is_ssa_section("  [script \t  INFO] bla", "script info"));
+  EXPECT_TRUE(is_ssa_section("[V4+ Styles]",            "v4+ styles"));
+  EXPECT_TRUE(is_ssa_section("[Events]",                "events"));
+
+  EXPECT_FALSE(is_ssa_section("[ScriptInfo]",           "script info"));
+  EXPECT_FALSE(is_ssa_section("[V4 Styles]",            "v4+ styles"));
+  EXPECT_FALSE(is_ssa_section("[V4+ Styles]",           "v4 styles"));
+  EXPECT_FALSE(is_ssa_section("x[Events]",              "events"));
+  EXPECT_FALSE(is_ssa_section("[Events",                "events"));
+  EXPECT_FALSE(is_ssa_section("",                       "events"));
+}
+
+TEST(TextSubtitles, SsaCommentOrEmpty) {
+  EXPECT_TRUE(is_ssa_comment_or_empty(""));
+  EXPECT_TRUE(is_ssa_comment_or_empty(" \t"));
+  EXPECT_TRUE(is_ssa_comment_or_empty("; comment"));
+  EXPECT_TRUE(is_ssa_comment_or_empty("  !: comment"));
+
+  EXPECT_FALSE(is_ssa_comment_or_empty("[Script Info]"));
+}
+
+TEST(TextSubtitles, SplitSsaFields) {
+  std::vector<std::string> fields{ "old", "values" };
+
+  split_ssa_fields("Dialogue: 0,0:00:01.00,0:00:02.00,Default,,Text, with, commas", 10, 6, fields);
+  EXPECT_EQ((std::vector<std::string>{ "0", "0:00:01.00", "0:00:02.00", "Default", "", "Text, with, commas" }), fields);
+
+  split_ssa_fields("a,b", 0, 4, fields);
+  EXPECT_EQ((std::vector<std::string>{ "a", "b", "", "" }), fields);
+
+  split_ssa_fields("a,", 0, 2, fields);
+  EXPECT_EQ((std::vector<std::string>{ "a", "" }), fields);
+
+  split_ssa_fields("a,b", 0, 1, fields);
+  EXPECT_EQ((std::vector<std::string>{ "a,b" }), fields);
+}
+
+TEST(TextSubtitles, NormalizeLineEndings) {
+  std::string dst;
+
+  normalize_line_endings("", 0, dst);
+  EXPECT_EQ("", dst);
+
+  std::string src{"Hello\r\nWorld\n\n"};
+  normalize_line_endings(src.c_str(), src.length(), dst);
+  EXPECT_EQ("Hello\r\nWorld", dst);
+
+  src = "\na\n\r\nb\r\r\n\r";
+  normalize_line_endings(src.c_str(), src.length(), dst);
+  EXPECT_EQ("\r\na\r\n\r\nb", dst);
+
+  src = "No line breaks";
+  normalize_line_endings(src.c_str(), src.length(), dst);
+  EXPECT_EQ(src, dst);
+}
+
+}
@@ -0,0 +1,70 @@
+#include "common/common_pch.h"
+
+#include "merge/packet.h"
+#include "merge/track_statistics.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+void
+add_frames(track_statistics_c &stats,
+           int64_t first_timecode,
+           int64_t duration,
+           size_t num_frames,
+           size_t size) {
+  for (auto idx = 0u; idx < num_frames; ++idx) {
+    auto packet              = packet_t{memory_c::alloc(size), first_timecode + idx * duration, duration};
+    packet.assigned_timecode = packet.timecode;
+    stats.process(packet);
+  }
+}
+
+TEST(TrackStatistics, NoFrames) {
+  auto stats = track_statistics_c{};
+
+  EXPECT_FALSE(!!stats.get_bits_per_second());
+  EXPECT_FALSE(!!stats.get_peak_bits_per_second());
+}
+
+TEST(TrackStatistics, ConstantBitrate) {
+  auto stats = track_statistics_c{};
+
+  // 10s, 1000 bytes every 100ms
+  add_frames(stats, 0, 100000000, 100, 1000);
+
+  EXPECT_EQ(80000, *stats.get_bits_per_second());
+  EXPECT_EQ(80000, *stats.get_peak_bits_per_second());
+}
+
+TEST(TrackStatistics, PeakWithinOneSecond) {
+  auto stats = track_statistics_c{};
+
+  add_frames(stats, 0,           100000000, 50, 1000);
+  add_frames(stats, 5000000000,  100000000,  1, 11000);
+  add_frames(stats, 5100000000,  100000000, 49, 1000);
+
+  EXPECT_EQ(88000,  *stats.get_bits_per_second());
+  EXPECT_EQ(160000, *stats.get_peak_bits_per_second());
+}
+
+TEST(TrackStatistics, ShorterThanOneSecond) {
+  auto stats = track_statistics_c{};
+
+  // 500ms, 1000 bytes every 50ms
+  add_frames(stats, 0, 50000000, 10, 1000);
+
+  EXPECT_EQ(160000, *stats.get_bits_per_second());
+  EXPECT_EQ(160000, *stats.get_peak_bits_per_second());
+}
+
+TEST(TrackStatistics, ShorterThanOneMillisecond) {
+  auto stats = track_statistics_c{};
+
+  add_frames(stats, 0, 100000, 1, 1000);
+
+  EXPECT_FALSE(!!stats.get_bits_per_second());
+  EXPECT_FALSE(!!stats.get_peak_bits_per_second());
+}
+
+}